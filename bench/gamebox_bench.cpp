@@ -0,0 +1,256 @@
+// Headless GameBox benchmark.
+// Steps GameWorld with scripted input, without a window or renderer, and
+// reports the average cost per simulation step, and of streaming per frame.
+// Scripted runs take one step per frame; a replay takes the recorded steps.
+//
+// Usage: gamebox_bench [--frames N] [--level FILE|generated] [--columns N]
+//                      [--replay FILE] [--check-respawn]
+// FILE is a text or cooked (.lvl) level, assets/levels/main.txt by default.
+// --replay steps the input recorded with `Gamw --record FILE` instead of
+// the script (on the level it was recorded on) and checks that the run
+// ends exactly as it did when recorded.
+// --check-respawn only checks that a player killed far from the start
+// respawns on solid ground, and exits non-zero if not.
+
+// Plain main(), no SDL2main and no SDL_Init needed
+#define SDL_MAIN_HANDLED
+
+#include "GameWorld.h"
+#include "InputReplay.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static long long elapsedNs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+      .count();
+}
+
+// Long level in the same format as assets/levels/main.txt: floating brick rows, '?'
+// blocks, coins and enemies repeated with some variation, ground below.
+static std::vector<std::string> generateLevel(int columns, unsigned int seed) {
+  const int rows = 20;
+  std::vector<std::string> level(rows, std::string(columns, ' '));
+  srand(seed);
+
+  level[19][2] = 'P';
+  for (int x = 20; x < columns - 20; x += 12 + rand() % 8) {
+    int row = 10 + rand() % 6;
+    int length = 3 + rand() % 5;
+    for (int i = 0; i < length && x + i < columns; i++) {
+      level[row][x + i] = (i == length / 2) ? '?' : 'B';
+      level[row - 2][x + i] = 'C';
+    }
+    level[19][x + length + 2] = (rand() % 2) ? 'E' : 'e';
+  }
+  return level;
+}
+
+struct StepTimings {
+  long long collisionNs = 0;
+  long long enemiesNs = 0;
+  long long entitiesNs = 0;
+  long long stepNs = 0;      // Whole steps, the phases above included
+  long long streamingNs = 0; // updateStreaming(), once per frame
+};
+
+// GameWorld::step() with the hot phases timed separately
+static void timedStep(GameWorld &world, const PlayerInput &input, float dt,
+                      StepTimings &timings) {
+  Clock::time_point start = Clock::now();
+  if (world.beginStep(dt) && world.stepPlayer(input, dt)) {
+    Clock::time_point collisionStart = Clock::now();
+    world.stepCollision();
+    Clock::time_point enemiesStart = Clock::now();
+    world.stepEnemies(dt);
+    Clock::time_point entitiesStart = Clock::now();
+    world.stepEntities(dt);
+    Clock::time_point entitiesEnd = Clock::now();
+
+    timings.collisionNs += elapsedNs(collisionStart, enemiesStart);
+    timings.enemiesNs += elapsedNs(enemiesStart, entitiesStart);
+    timings.entitiesNs += elapsedNs(entitiesStart, entitiesEnd);
+  }
+  timings.stepNs += elapsedNs(start, Clock::now());
+}
+
+static void timedStreaming(GameWorld &world, StepTimings &timings) {
+  Clock::time_point start = Clock::now();
+  world.updateStreaming();
+  timings.streamingNs += elapsedNs(start, Clock::now());
+}
+
+// Kill the player far from the start, let it respawn and stand still for
+// a while. The start chunks were paged out meanwhile; the respawn has to
+// bring them back before the player falls through the ground.
+static bool checkRespawn(const CookedLevel &level) {
+  const float STEP = 1.0f / 120.0f;
+  GameWorld world;
+  world.load(level, 1280, 720, 42u);
+
+  // Run right for ten seconds, then die on the spot
+  PlayerInput run;
+  run.right = true;
+  for (int i = 0; i < 1200; i++) {
+    world.playerStatus.isInvincible = true;
+    world.playerStatus.invincibleEndTime = ~0u;
+    world.step(run, STEP);
+    world.updateStreaming();
+  }
+  float deathX = world.playerX;
+  world.playerStatus.isInvincible = false;
+  world.lives--;
+  world.deathCount++;
+  world.isDying = true;
+  world.dyingStartTime = world.currentTime;
+  int deaths = world.deathCount;
+
+  // Death animation (4 s), respawn, then two seconds idle
+  PlayerInput idle;
+  for (int i = 0; i < 6 * 120; i++) {
+    world.step(idle, STEP);
+    world.updateStreaming();
+  }
+
+  bool ok = !world.isDying && world.deathCount == deaths && world.isOnGround;
+  printf("Respawn after dying at x=%.0f: %s (x=%.1f y=%.1f)\n", deathX,
+         ok ? "ok" : "FELL THROUGH", world.playerX, world.playerY);
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  int frames = 100000;
+  int columns = 4000;
+  std::string levelPath = "assets/levels/main.txt";
+  std::string replayPath;
+  bool respawnOnly = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frames = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--columns") == 0 && i + 1 < argc) {
+      columns = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+      levelPath = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      replayPath = argv[++i];
+    } else if (strcmp(argv[i], "--check-respawn") == 0) {
+      respawnOnly = true;
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--frames N] [--level FILE|generated] [--columns N]"
+                << " [--replay FILE] [--check-respawn]" << std::endl;
+      return 1;
+    }
+  }
+
+  CookedLevel level;
+  bool loaded = levelPath == "generated"
+                    ? level.openRows(generateLevel(columns, 1234u))
+                    : level.open(levelPath);
+  if (!loaded)
+    return 1;
+
+  if (respawnOnly) {
+    Logger::instance().setLevel(LOG_LEVEL_OFF);
+    return checkRespawn(level) ? 0 : 1;
+  }
+
+  const float STEP = 1.0f / 120.0f;
+  const int VIEW_WIDTH = 1280;
+  const int VIEW_HEIGHT = 720;
+
+  // Gameplay events are logged; keep them out of the timing
+  Logger::instance().setLevel(LOG_LEVEL_OFF);
+
+  StepTimings timings;
+  int framesRun = 0;
+  long long steps = 0;
+  int runs = 0;
+  int deaths = 0;
+  bool replayMatched = false;
+
+  if (!replayPath.empty()) {
+    InputReplay replay;
+    if (!replay.load(replayPath))
+      return 1;
+    if (replay.getLevelColumns() != level.getColumns() ||
+        replay.getLevelRows() != level.getRows()) {
+      std::cerr << "Replay was recorded on a different level" << std::endl;
+      return 1;
+    }
+
+    // Same steps per frame and streaming updates as the recorded run
+    GameWorld world;
+    world.load(level, replay.getViewWidth(), replay.getViewHeight(),
+               replay.getSeed());
+    double frameTime;
+    int stepCount;
+    PlayerInput input;
+    while (replay.nextFrame(&frameTime, &stepCount)) {
+      for (int i = 0; i < stepCount && replay.nextStep(&input); i++) {
+        timedStep(world, input, STEP, timings);
+        steps++;
+      }
+      timedStreaming(world, timings);
+      framesRun++;
+    }
+    runs = 1;
+    deaths = world.deathCount;
+    replayMatched = ReplayResult::capture(world) == replay.getResult();
+  }
+
+  std::unique_ptr<GameWorld> world;
+  for (int frame = 0; replayPath.empty() && frame < frames; frame++) {
+    if (!world || world->gameOver || world->levelComplete) {
+      if (world)
+        deaths += world->deathCount;
+      world.reset(new GameWorld());
+      world->load(level, VIEW_WIDTH, VIEW_HEIGHT, 42u);
+      runs++;
+    }
+
+    // Scripted input: keep running right and jump at a steady rhythm
+    PlayerInput input;
+    input.right = true;
+    input.jump = frame % 45 == 0;
+
+    timedStep(*world, input, STEP, timings);
+    steps++;
+    timedStreaming(*world, timings);
+    framesRun++;
+  }
+  deaths += world ? world->deathCount : 0;
+
+  std::cout << "Level: " << levelPath << ", " << level.getColumns()
+            << " columns" << std::endl;
+  std::cout << "Frames: " << framesRun << ", steps: " << steps << " ("
+            << runs << " runs, " << deaths << " deaths)" << std::endl;
+
+  if (!replayPath.empty()) {
+    std::cout << "Replay: " << replayPath << ", "
+              << (replayMatched ? "matches the recording"
+                                : "DIVERGED from the recording")
+              << std::endl;
+  }
+
+  if (steps > 0) {
+    printf("collision  %10.1f ns/step\n", double(timings.collisionNs) / steps);
+    printf("enemies    %10.1f ns/step\n", double(timings.enemiesNs) / steps);
+    printf("entities   %10.1f ns/step\n", double(timings.entitiesNs) / steps);
+    printf("step       %10.1f ns/step\n", double(timings.stepNs) / steps);
+  }
+  if (framesRun > 0) {
+    printf("streaming  %10.1f ns/frame\n",
+           double(timings.streamingNs) / framesRun);
+  }
+  return replayPath.empty() || replayMatched ? 0 : 1;
+}
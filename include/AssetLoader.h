@@ -0,0 +1,54 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Background loading thread with a job queue.
+// A job runs on the loader thread and does the slow CPU work (file I/O,
+// level parsing, building chunks). It returns a finalizer, which
+// finishPending() later runs on the main thread: anything that touches
+// the renderer (texture uploads, glyph atlases) belongs there, since SDL
+// rendering is single-threaded.
+class AssetLoader {
+public:
+  typedef std::function<void()> Finalizer;
+  typedef std::function<Finalizer()> Job;
+
+  AssetLoader();
+  ~AssetLoader(); // Calls stop()
+
+  // Queue `job`; the loader thread is started on first use
+  void submit(const Job &job);
+
+  // Run the finalizers of finished jobs, in submission order. Main thread
+  // only. Returns how many ran.
+  int finishPending();
+
+  // True while a job is queued, running, or waiting to be finalized
+  bool busy();
+
+  // Finish the running job, drop queued ones and join the thread.
+  // Unfinalized results are discarded.
+  void stop();
+
+private:
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader &operator=(const AssetLoader &) = delete;
+
+  void workerMain();
+
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<Job> jobs;
+  std::vector<Finalizer> finished;
+  int running;
+  bool stopping;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef COOKEDLEVEL_H
+#define COOKEDLEVEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary level format written by the levelcook tool.
+// Layout (little-endian, every section 4-byte aligned):
+//   CookedLevelHeader
+//   tiles    columns * rows bytes, column-major: tile (col, row) is at
+//            col * rows + row and is one of ' ', 'G', 'B', '?'
+//   coins    coinCount CookedCoin, sorted by column then row
+//   enemies  enemyCount CookedEnemy, sorted by column then row
+// Columns being contiguous lets the streamer read a chunk's tiles and
+// entities in place, straight out of the mapped file.
+// Entity positions are 16-bit, so levels are limited to COOKED_MAX_EXTENT
+// columns and rows.
+struct CookedLevelHeader {
+  char magic[8];     // "GAMWLVL" + '\0'
+  uint32_t version;  // COOKED_LEVEL_VERSION
+  uint32_t columns;
+  uint32_t rows;
+  int32_t playerColumn; // -1 if the level has no 'P'
+  int32_t playerRow;
+  uint32_t tilesOffset;
+  uint32_t coinCount;
+  uint32_t coinsOffset;
+  uint32_t enemyCount;
+  uint32_t enemiesOffset;
+  uint32_t fileSize;
+};
+
+struct CookedCoin {
+  uint16_t column;
+  uint16_t row;
+};
+
+struct CookedEnemy {
+  uint16_t column;
+  uint16_t row;
+  uint8_t movesRight; // 'E' = 1, 'e' = 0
+  uint8_t reserved;
+};
+
+const uint32_t COOKED_LEVEL_VERSION = 1;
+const uint32_t COOKED_MAX_EXTENT = 65535;
+
+// A level ready for LevelStreamer: either a cooked file mapped into memory,
+// or text rows cooked into an owned buffer when no cooked file exists.
+class CookedLevel {
+public:
+  CookedLevel();
+  ~CookedLevel();
+
+  // Open `path`: files ending in ".lvl" are mapped, anything else is read
+  // as a text level and cooked in memory. Prints the reason on failure.
+  bool open(const std::string &path);
+  bool openCooked(const std::string &path);
+  bool openText(const std::string &path);
+
+  // Cook rows that are already in memory (generated levels, tests)
+  bool openRows(const std::vector<std::string> &rows);
+
+  void close();
+  bool isOpen() const { return header != nullptr; }
+
+  int getColumns() const { return static_cast<int>(header->columns); }
+  int getRows() const { return static_cast<int>(header->rows); }
+  int getPlayerColumn() const { return header->playerColumn; }
+  int getPlayerRow() const { return header->playerRow; }
+
+  char tileAt(int column, int row) const {
+    return tiles[column * header->rows + row];
+  }
+
+  // Entities with firstColumn <= column < lastColumn
+  const CookedCoin *findCoins(int firstColumn, int lastColumn,
+                              size_t *count) const;
+  const CookedEnemy *findEnemies(int firstColumn, int lastColumn,
+                                 size_t *count) const;
+
+  // Offline side, used by levelcook. Text levels are one row per line;
+  // lines starting with '#' are comments.
+  static bool readTextRows(const std::string &path,
+                           std::vector<std::string> &rows);
+  // Fails, printing why, when the level is larger than COOKED_MAX_EXTENT
+  // in either direction
+  static bool cook(const std::vector<std::string> &rows,
+                   std::vector<unsigned char> &out);
+
+private:
+  CookedLevel(const CookedLevel &) = delete;
+  CookedLevel &operator=(const CookedLevel &) = delete;
+
+  // Check the header, the section bounds of `size` bytes at `data`, and
+  // that entities lie inside the level in column order
+  bool attach(const unsigned char *data, size_t size,
+              const std::string &path);
+
+  const CookedLevelHeader *header;
+  const char *tiles;
+  const CookedCoin *coins;
+  const CookedEnemy *enemies;
+
+  // Exactly one of these backs the data while open
+  std::vector<unsigned char> owned;
+  void *mapping;
+  size_t mappingSize;
+#ifdef _WIN32
+  void *fileHandle;
+  void *mappingHandle;
+#endif
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+// Remove element `index` by shifting the ones after it down.
+// O(n), but keeps the remaining elements in order.
+template <typename T> void orderedRemove(std::vector<T> &values, size_t index) {
+  values.erase(values.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+// Fixed-capacity pool of short-lived entities (items, floating texts).
+// All slots are allocated up front, so spawning never allocates. Live
+// entities are kept packed at the front: remove() moves the last live
+// entity into the freed slot, so iteration only ever sees live ones.
+//
+// Removing while iterating: don't advance the index after remove(i),
+// the slot now holds an entity that hasn't been visited yet.
+template <typename T> class EntityPool {
+public:
+  explicit EntityPool(size_t capacity) : slots(capacity), count(0) {}
+
+  // Copy `value` into a free slot. Returns false (and drops the entity)
+  // when the pool is full.
+  bool add(const T &value) {
+    if (count == slots.size())
+      return false;
+    slots[count++] = value;
+    return true;
+  }
+
+  void remove(size_t index) {
+    if (index + 1 < count)
+      slots[index] = slots[count - 1];
+    count--;
+  }
+
+  void clear() { count = 0; }
+
+  size_t size() const { return count; }
+  size_t capacity() const { return slots.size(); }
+  bool empty() const { return count == 0; }
+
+  T &operator[](size_t index) { return slots[index]; }
+  const T &operator[](size_t index) const { return slots[index]; }
+
+  // Live entities only
+  T *begin() { return slots.data(); }
+  T *end() { return slots.data() + count; }
+  const T *begin() const { return slots.data(); }
+  const T *end() const { return slots.data() + count; }
+
+private:
+  std::vector<T> slots;
+  size_t count;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <vector>
+
+const int ENEMY_SIZE = 28;
+const int COIN_SIZE = 16;
+
+// Enemies of one level chunk, stored as structure-of-arrays so the hot
+// loops (movement, overlap tests) stream through just the fields they use.
+// Enemy i is (x[i], y[i], vx[i], ...); its rect is
+// {int(x), int(y), ENEMY_SIZE, ENEMY_SIZE}.
+// Enemies are kept sorted by x. They walk, so the order is restored by
+// sortByX() after every move.
+struct EnemyStore {
+  std::vector<float> x, y;
+  std::vector<float> vx, vy;
+  std::vector<float> prevX, prevY; // Position at the previous step
+  std::vector<int> spawnChunk;   // Chunk that spawned this enemy
+  std::vector<int> spawnIndex;   // Spawn order inside that chunk
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  void add(float x, float y, float vx, int spawnChunk, int spawnIndex);
+  void addFrom(const EnemyStore &other, size_t index); // Inserts in x order
+  void remove(size_t index); // Keeps the order of the others
+  void clear();
+
+  // Restore ascending x order. Insertion sort: after one step of movement
+  // the store is almost sorted, so this is close to a single pass.
+  void sortByX();
+
+private:
+  void swapEntries(size_t a, size_t b);
+};
+
+// Coins of one level chunk. (x[i], y[i]) is the center of coin i.
+// Coins are spawned in column order and never move, so x stays sorted.
+struct CoinStore {
+  std::vector<float> x, y;
+  std::vector<float> animPhase;
+  std::vector<int> spawnIndex; // Spawn order inside its chunk
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  void add(float x, float y, int spawnIndex);
+  void remove(size_t index); // Keeps the order of the others
+  void clear();
+};
+
+// Batch updates over whole stores. These use SSE2 when the compiler
+// targets it (always on x86-64) and plain loops otherwise; define
+// GAMW_NO_SIMD to force the scalar code. Both paths give identical
+// results.
+
+// Add `delta` to every coin's animation phase
+void advanceCoins(CoinStore &coins, float delta);
+
+// Append the index of every entity whose rect {int(x[i]) + offset,
+// int(y[i]) + offset, size, size} intersects `area`, in ascending order.
+// Same rule as SDL_HasIntersection.
+void findOverlaps(const std::vector<float> &x, const std::vector<float> &y,
+                  int offset, int size, const SDL_Rect &area,
+                  std::vector<int> &hits);
+
+// Range [first, last) of a store sorted by x with x in [minX, maxX]
+void sortedRange(const std::vector<float> &x, float minX, float maxX,
+                 size_t &first, size_t &last);
+
+// Broadphase for stores sorted by x (sort and sweep): same result as
+// findOverlaps, but only the run of entities whose x can reach `area` is
+// tested, found by binary search. O(log n + nearby) instead of O(n).
+void findOverlapsSorted(const std::vector<float> &x,
+                        const std::vector<float> &y, int offset, int size,
+                        const SDL_Rect &area, std::vector<int> &hits);
+
+#endif
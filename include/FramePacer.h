@@ -0,0 +1,54 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+
+// Idle-aware frame pacing, shared by the menu loop and the game loop.
+// At full rate frames are paced by vsync alone. When nothing needs it,
+// the loops drop to a low frame rate and sleep in SDL_WaitEventTimeout
+// between frames, so any input still wakes them at once:
+//   IDLE        no input for IDLE_AFTER_MS, or a static screen (game over)
+//   BACKGROUND  the window has lost focus
+//   MINIMIZED   the window is minimized or hidden; nothing is rendered
+// Input or regaining the window returns to full rate on the next frame.
+//
+// Main thread only.
+class FramePacer {
+public:
+  enum class Mode { ACTIVE, IDLE, BACKGROUND, MINIMIZED };
+
+  static const Uint32 IDLE_AFTER_MS = 10000;
+  static const int IDLE_FPS = 20;
+  static const int BACKGROUND_FPS = 10;
+  static const int MINIMIZED_FPS = 4;
+
+  static FramePacer &instance();
+
+  // Pass every event from SDL_PollEvent
+  void onEvent(const SDL_Event &event);
+
+  // Back to full rate as if there had been input (state changes, loading)
+  void wake();
+
+  // Mode for the next frame. quiet: the screen is static enough to idle
+  // right away.
+  Mode mode(bool quiet = false) const;
+
+  // Sleeps until the next frame is due in the current mode, or until an
+  // event arrives. Returns at once at full rate.
+  void waitForFrame(bool quiet = false);
+
+  bool isMinimized() const { return minimized; }
+
+private:
+  FramePacer();
+  FramePacer(const FramePacer &) = delete;
+  FramePacer &operator=(const FramePacer &) = delete;
+
+  Uint32 lastInputTime;
+  Uint32 lastFrameTime;
+  bool focused;
+  bool minimized;
+};
+
+#endif
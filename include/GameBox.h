@@ -4,6 +4,8 @@
     #include <SDL2/SDL.h>
     #include <vector>
     #include <string>
+
+    const int TILE_SIZE = 32;
     
     // Add this enum BEFORE the Platform struct
 enum class ItemType {
@@ -21,39 +23,21 @@ enum class ItemType {
         ItemType containedItem; 
     };
 
-    struct Enemy {
-        float x, y;
-        float vx;
-        SDL_Rect rect;
-        bool active;
-        float leftBound;    // Tambahan: batas kiri enemy patrol
-        float rightBound;   // Tambahan: batas kanan enemy patrol
-    };
-
-    struct Coin {
-        int x, y;
-        bool collected;
-        float animPhase;
-    };
+    // Enemies and coins are stored per level chunk, see EntityStore.h
 
     struct FloatingText {
         float x, y;
         float vy;
+        float prevY;        // y at the previous simulation step
         int value;
         Uint32 spawnTime;
-        bool active;
     };
 
-    // Struct baru untuk level chunk system
-    struct LevelChunk {
-        std::vector<Platform> platforms;
-        std::vector<Coin> coins;
-        std::vector<Enemy> enemies;
-        int startX;         // Posisi X awal chunk
-        int width;          // Lebar chunk dalam pixels
-    };
+    class GameSession;
 
-    bool runGameBox(SDL_Renderer* renderer);
+    // Plays a prepared session (see GameSession.h). Returns true to play
+    // again (the session is already restarted), false to go back to menu.
+    bool runGameBox(SDL_Renderer* renderer, GameSession& session);
     extern int currentStage;
 
     #endif
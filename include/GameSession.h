@@ -0,0 +1,74 @@
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <memory>
+#include <string>
+
+#include "CookedLevel.h"
+#include "GameWorld.h"
+#include "InputReplay.h"
+#include "ParallaxLayers.h"
+#include "SpriteAtlas.h"
+#include "TileTextures.h"
+
+enum class ReplayMode {
+  OFF,
+  RECORD, // Record this run's input to replayPath
+  PLAY    // Drive the run from the replay at replayPath
+};
+
+// Everything one play session needs, prepared in two halves so the menu
+// keeps animating while it loads:
+//   load()   CPU work only (level file, world and chunk setup). Safe to
+//            run on the AssetLoader thread.
+//   upload() fonts, glyph atlases, tile and sprite textures. Main thread
+//            only, after load() succeeded.
+class GameSession {
+public:
+  GameSession();
+  ~GameSession(); // Main thread: releases fonts and textures
+
+  // Set before load(). When playing, the replay's seed and view size
+  // replace the ones passed to load().
+  void setReplay(ReplayMode mode, const std::string &path);
+
+  bool load(int viewWidth, int viewHeight, unsigned int seed);
+  void upload(SDL_Renderer *renderer);
+
+  // Fresh world on the already open level (R after game over)
+  void restart(unsigned int seed);
+
+  // End of a recorded or replayed run: saves the recording, or checks the
+  // replay ended in the recorded state. Replay is OFF afterwards.
+  void endReplay();
+
+  bool isLoaded() const { return world != nullptr; }
+
+  CookedLevel level;
+  std::unique_ptr<GameWorld> world;
+
+  TileTextures tileTextures;
+  ParallaxLayers parallax;
+  SpriteAtlas sprites;
+  TTF_Font *gameFont;
+  TTF_Font *smallFont;
+
+  ReplayMode replayMode;
+  InputReplay replay;
+
+  // Set when the game loop saw SDL_RENDER_TARGETS_RESET; the menu's render
+  // targets were lost too
+  bool renderTargetsReset;
+
+private:
+  GameSession(const GameSession &) = delete;
+  GameSession &operator=(const GameSession &) = delete;
+
+  int viewWidth;
+  int viewHeight;
+  std::string replayPath;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+#include "EntityPool.h"
+#include "GameBox.h"
+#include "LevelStreamer.h"
+
+// Game constants
+const float GRAVITY = 1200.0f;
+const float JUMP_FORCE = -700.0f;
+const float MOVE_SPEED = 250.0f;
+const int PLAYER_SIZE = 32;
+
+// Camera offset - jarak player dari tepi kiri layar
+const int CAMERA_OFFSET_X = 200;
+
+// Day-Night Cycle (5 minutes = 300 seconds for full cycle)
+const float DAY_CYCLE_DURATION = 300.0f;
+
+// Item structure
+struct Item {
+  float x, y;
+  float vy;    // Vertical velocity (for popping out animation)
+  float prevY; // y at the previous simulation step, for interpolation
+  ItemType type;
+  Uint32 spawnTime;
+  SDL_Rect rect;
+};
+
+// Player buffs/debuffs
+struct PlayerStatus {
+  bool hasSword = false;     // Faster movement
+  bool isPoisoned = false;   // Slower movement
+  bool isInvincible = false; // Can't be hurt
+  Uint32 swordEndTime = 0;
+  Uint32 poisonEndTime = 0;
+  Uint32 invincibleEndTime = 0;
+};
+
+// Buttons held during one simulation step
+struct PlayerInput {
+  bool left = false;
+  bool right = false;
+  bool jump = false; // Jump was pressed since the last step
+};
+
+// Everything GameBox simulates, without a window or renderer.
+// runGameBox feeds it keyboard input and draws it; the headless benchmark
+// drives it with scripted input. step() is one fixed timestep and is made
+// of the phases below, which are public so they can be timed separately.
+class GameWorld {
+public:
+  GameWorld();
+
+  // viewWidth/viewHeight is the visible area; the ground sits at the
+  // bottom of it and the camera is clamped to it
+  // `level` must stay open as long as the world uses it
+  void load(const CookedLevel &level, int viewWidth, int viewHeight,
+            unsigned int itemSeed);
+
+  void step(const PlayerInput &input, float deltaTime);
+
+  // Phases of step(), in order. beginStep() and stepPlayer() return false
+  // when the rest of the step must be skipped (game over, dying).
+  bool beginStep(float deltaTime);
+  bool stepPlayer(const PlayerInput &input, float deltaTime);
+  void stepCollision();
+  void stepEnemies(float deltaTime);
+  void stepEntities(float deltaTime);
+
+  // Page chunks around the camera. Once per frame is enough.
+  void updateStreaming();
+
+  int viewWidth, viewHeight;
+  int levelWidthPixels;
+
+  // Player state
+  float playerX, playerY;
+  float playerStartX, playerStartY;
+  float velocityX, velocityY;
+  bool isOnGround;
+  bool facingRight;
+  PlayerStatus playerStatus;
+
+  // Camera position (world coordinate)
+  float cameraX;
+
+  // State at the previous step, for render interpolation
+  float prevPlayerX, prevPlayerY, prevCameraX;
+
+  // Game state
+  int score;
+  int lives;
+  bool gameOver;
+  bool levelComplete;
+  Uint32 deathTime;
+  bool isDying;
+  Uint32 dyingStartTime;
+  float deathFallVelocity;
+  int deathCount;
+
+  // Animation
+  float animPhase;
+
+  // 0.0 = midnight, 0.25 = sunrise, 0.5 = noon, 0.75 = sunset
+  float dayTime;
+
+  // Simulated clock; gameplay timers use this instead of SDL_GetTicks
+  double simTime;
+  Uint32 currentTime;
+
+  // Live items and texts only; dead ones are removed right away
+  static const size_t MAX_ITEMS = 32;
+  static const size_t MAX_FLOATING_TEXTS = 64;
+  EntityPool<Item> items;
+  EntityPool<FloatingText> floatingTexts;
+
+  // Game objects live in level chunks that are paged in around the camera
+  LevelStreamer streamer;
+
+  // Enemies further than this beyond either edge of the view sleep: they
+  // keep their place until the camera comes near again. Capped to the
+  // streaming margin.
+  float enemyWakeDistance;
+
+private:
+  GameWorld(const GameWorld &) = delete;
+  GameWorld &operator=(const GameWorld &) = delete;
+
+  // Carried from stepPlayer() to the later phases
+  float oldX, oldY;
+  SDL_Rect playerRect;
+
+  // Whether a level platform covers the pixel (x, y)
+  bool solidAt(int x, int y);
+
+  std::vector<Platform *> nearbyPlatforms;
+
+  // Scratch lists for the batched overlap tests
+  std::vector<int> hits;
+  std::vector<int> defeated;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef INPUTREPLAY_H
+#define INPUTREPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GameWorld.h"
+
+// State at the end of a recording, to check that a replay matched it
+struct ReplayResult {
+  int32_t score;
+  int32_t lives;
+  int32_t deathCount;
+  float playerX, playerY;
+
+  static ReplayResult capture(const GameWorld &world);
+  bool operator==(const ReplayResult &other) const;
+};
+
+// Recorded play session: everything GameWorld needs to redo a run bit for
+// bit (item seed, view size, the input of every simulation step) plus the
+// real frame times, so a rendered replay also repeats the original frame
+// pacing and stutters.
+//
+// File layout (little-endian):
+//   ReplayHeader
+//   frames  frameCount x { double frameTime; uint32_t stepCount; }
+//   steps   stepCount x uint8_t (PlayerInput bits, see packInput)
+class InputReplay {
+public:
+  InputReplay();
+
+  // Recording. startRecording() clears any previous content.
+  void startRecording(unsigned int seed, int viewWidth, int viewHeight,
+                      int levelColumns, int levelRows);
+  void recordFrame(double frameTime); // Once per frame, before its steps
+  void recordStep(const PlayerInput &input);
+  void finishRecording(const GameWorld &world);
+
+  bool save(const std::string &path) const;
+  bool load(const std::string &path); // Prints the reason on failure
+
+  // Playback cursors, advanced independently
+  void rewind();
+  bool nextFrame(double *frameTime, int *stepCount);
+  bool nextStep(PlayerInput *input);
+  bool atEnd() const { return frameCursor >= frames.size(); }
+
+  unsigned int getSeed() const { return seed; }
+  int getViewWidth() const { return viewWidth; }
+  int getViewHeight() const { return viewHeight; }
+  int getLevelColumns() const { return levelColumns; }
+  int getLevelRows() const { return levelRows; }
+  size_t getFrameCount() const { return frames.size(); }
+  size_t getStepCount() const { return steps.size(); }
+  const ReplayResult &getResult() const { return result; }
+
+  static uint8_t packInput(const PlayerInput &input);
+  static PlayerInput unpackInput(uint8_t bits);
+
+private:
+  struct Frame {
+    double frameTime;
+    uint32_t stepCount;
+  };
+
+  unsigned int seed;
+  int viewWidth, viewHeight;
+  int levelColumns, levelRows;
+  std::vector<Frame> frames;
+  std::vector<uint8_t> steps;
+  ReplayResult result;
+
+  size_t frameCursor;
+  size_t stepCursor;
+};
+
+#endif
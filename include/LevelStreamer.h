@@ -0,0 +1,112 @@
+#ifndef LEVELSTREAMER_H
+#define LEVELSTREAMER_H
+
+#include <SDL2/SDL.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "CookedLevel.h"
+#include "EntityStore.h"
+#include "GameBox.h"
+#include "TileGrid.h"
+
+// One vertical slice of the level. Only chunks near the camera exist in
+// memory; everything else is rebuilt from the level source on demand.
+// Platforms, coins and enemies are each kept sorted by x, so anything
+// that wants a band of the level can binary-search it.
+struct LevelChunk {
+  std::vector<Platform> platforms; // Sorted by rect.x
+  CoinStore coins;
+  EnemyStore enemies;
+  TileGrid grid;      // Collision grid over this chunk's platforms
+  int index;          // Chunk number (startX / width)
+  int startX;         // Posisi X awal chunk
+  int width;          // Lebar chunk dalam pixels
+};
+
+// Range [first, last) of the platforms of `chunk` with rect.x in
+// [minX, maxX]
+void platformRange(const LevelChunk &chunk, int minX, int maxX, size_t &first,
+                   size_t &last);
+
+// Pages LevelChunks in and out around the camera.
+// Chunks are built straight from the cooked level when they come into range
+// and freed when they leave it, so memory and per-frame work depend on the
+// screen width, not the level width. What the player changed in a chunk
+// (collected coins, defeated enemies, hit blocks) is kept in a few bits per
+// chunk and reapplied when it is paged back in.
+class LevelStreamer {
+public:
+  static const int CHUNK_COLUMNS = 16;  // 512px per chunk
+
+  LevelStreamer();
+
+  // Takes the level's size and player start. No chunk is built until
+  // update() is called. `level` must stay open while it is loaded.
+  // `itemSeed` decides the items hidden in '?' blocks, so a block keeps its
+  // item across page-ins.
+  void load(const CookedLevel &level, int windowHeight,
+            unsigned int itemSeed);
+  void unload();
+
+  // Make the chunks around [cameraX, cameraX + viewWidth) resident and
+  // page out the rest
+  void update(float cameraX, int viewWidth);
+
+  // Record the player's progress and remove the entity from `chunk`
+  // (swap-remove, so the last entity moves to `index`)
+  void collectCoin(LevelChunk &chunk, size_t index);
+  void defeatEnemy(LevelChunk &chunk, size_t index);
+
+  // Mark a '?' block of a resident chunk as used. Bumps the chunk's
+  // revision, so anything drawn from the chunk knows to redraw.
+  void hitBlock(Platform &block);
+
+  // Changes every time the look of chunk `index` changes (blocks hit).
+  // Kept across page-outs.
+  unsigned int getChunkRevision(int index) const {
+    return states[index].revision;
+  }
+
+  // Platforms of resident chunks whose grid cells overlap `area`
+  void queryPlatforms(const SDL_Rect &area, std::vector<Platform *> &out);
+
+  std::deque<LevelChunk> &getResidentChunks() { return resident; }
+  const std::deque<LevelChunk> &getResidentChunks() const { return resident; }
+
+  int getWidthPixels() const { return levelColumns * TILE_SIZE; }
+  int getChunkCount() const { return chunkCount; }
+  float getPlayerStartX() const { return playerStartX; }
+  float getPlayerStartY() const { return playerStartY; }
+
+private:
+  // Per-chunk memory of player progress, indexed by spawn order
+  struct ChunkState {
+    std::vector<bool> blockHit;
+    std::vector<bool> coinCollected;
+    std::vector<bool> enemyDefeated;
+    std::vector<bool> enemyAway;  // Alive, but handed over to another chunk
+    unsigned int revision = 0;
+  };
+
+  void buildChunk(int index, LevelChunk &chunk);
+  void pageIn(int index, bool atFront);
+  void pageOut(bool atFront);
+  LevelChunk *findResidentChunk(float worldX, int excludeIndex);
+
+  const CookedLevel *levelData;
+  int levelColumns;
+  int levelRows;
+  int groundY;
+  int chunkCount;
+  unsigned int itemSeed;
+  float playerStartX;
+  float playerStartY;
+
+  std::deque<LevelChunk> resident;  // Sorted by index, contiguous
+  std::vector<ChunkState> states;
+  std::vector<int> scratch;
+};
+
+#endif
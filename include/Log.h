@@ -0,0 +1,93 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+enum LogLevel {
+  LOG_LEVEL_DEBUG,
+  LOG_LEVEL_INFO,
+  LOG_LEVEL_WARN,
+  LOG_LEVEL_ERROR,
+  LOG_LEVEL_OFF
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GAMW_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define GAMW_PRINTF_FORMAT(fmt, args)
+#endif
+
+// Logging that keeps stdout out of the frame loop.
+// write() formats the message straight into a slot of a fixed ring buffer
+// (lock-free, any thread) and returns; a background thread drains the ring
+// to stdout and flushes once per batch. When the ring is full, messages
+// are dropped and counted rather than blocking the caller.
+//
+// Use the LOG_* macros. Building with GAMW_NO_LOG compiles them out; the
+// arguments are still type-checked but never evaluated.
+class Logger {
+public:
+  static const size_t CAPACITY = 1024; // Power of two
+  static const size_t MESSAGE_SIZE = 120;
+
+  static Logger &instance();
+
+  // Start the drain thread. Until then messages wait in the ring.
+  void start();
+  // Write out everything queued so far and join the drain thread
+  void stop();
+
+  void setLevel(LogLevel level) { minLevel.store(level); }
+  bool isEnabled(LogLevel level) const { return level >= minLevel.load(); }
+
+  void write(LogLevel level, const char *format, ...) GAMW_PRINTF_FORMAT(3, 4);
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    double time; // Seconds since the logger was created
+    char text[MESSAGE_SIZE];
+  };
+
+  Logger();
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  // Drain thread side. Returns the number of messages written.
+  size_t drain();
+  void drainMain();
+
+  Slot slots[CAPACITY];
+  std::atomic<size_t> writePosition;
+  size_t readPosition; // Only touched by the draining thread
+  std::atomic<size_t> dropped;
+  std::atomic<int> minLevel;
+
+  std::thread drainer;
+  std::atomic<bool> running;
+};
+
+#ifdef GAMW_NO_LOG
+#define GAMW_LOG(level, ...)                                                  \
+  do {                                                                        \
+    if (0)                                                                    \
+      Logger::instance().write(level, __VA_ARGS__);                           \
+  } while (0)
+#else
+#define GAMW_LOG(level, ...)                                                  \
+  do {                                                                        \
+    Logger &gamwLogger = Logger::instance();                                  \
+    if (gamwLogger.isEnabled(level))                                          \
+      gamwLogger.write(level, __VA_ARGS__);                                   \
+  } while (0)
+#endif
+
+#define LOG_DEBUG(...) GAMW_LOG(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) GAMW_LOG(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) GAMW_LOG(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) GAMW_LOG(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif
@@ -6,8 +6,13 @@
 #include <vector>
 #include <string>
 
+#include "ParallaxLayers.h"
+#include "RenderBatch.h"
+#include "SkyLayer.h"
+
 enum GameState {
     MENU,
+    LOADING,    // Game is being prepared, the menu keeps animating
     PLAYING,
     SETTINGS,
     PAUSED
@@ -23,11 +28,6 @@ struct MenuItem {
         : text(t), rect{x, y, w, h}, hovered(false), selectAnim(0.0f) {}
 };
 
-struct Cloud {
-    float x, y;
-    float speed;
-};
-
 class Menu {
 public:
     Menu();
@@ -39,6 +39,13 @@ public:
     void render(SDL_Renderer* renderer);
     void cleanup();
     
+    // Shows a loading line in place of the controls footer
+    void setLoading(bool isLoading) { loading = isLoading; }
+    
+    // Drops the render target caches; they are baked again on the next
+    // frame. Call after every SDL_RENDER_TARGETS_RESET, whatever the state.
+    void onRenderTargetsReset();
+    
 private:
     // Event handling
     void handleKeyboard(SDL_Event& e);
@@ -48,18 +55,25 @@ private:
     // Rendering functions
     void renderBackground(SDL_Renderer* renderer);
     void renderClouds(SDL_Renderer* renderer);
-    void renderGround(SDL_Renderer* renderer);
-    void renderDecorations(SDL_Renderer* renderer);
+    void renderGround();
+    void renderDecorations();
     void renderTitle(SDL_Renderer* renderer);
     void renderItems(SDL_Renderer* renderer);
     void renderMenuItem(SDL_Renderer* renderer, MenuItem& item, bool isSelected);
+    void renderButton(const SDL_Rect& r, bool isSelected);
     void renderFooter(SDL_Renderer* renderer);
     
+    // Retained static layer: the ground, pipes and idle buttons composited
+    // into one texture, plus the selected button on its own. Built once
+    // the fade-in is over, dropped on resize.
+    bool buildStaticLayer(SDL_Renderer* renderer);
+    void releaseStaticLayer();
+    
     // Decoration rendering
-    void renderQuestionBlock(SDL_Renderer* renderer, int x, int y);
-    void renderPipe(SDL_Renderer* renderer, int x, int y);
-    void renderStar(SDL_Renderer* renderer, int x, int y);
-    void renderCoin(SDL_Renderer* renderer, int x, int y, float rotation);
+    void renderQuestionBlock(int x, int y);
+    void renderPipe(int x, int y);
+    void renderStar(int x, int y);
+    void renderCoin(int x, int y, float rotation);
     void renderMushroom(SDL_Renderer* renderer, int x, int y);
     
     // Text rendering
@@ -67,13 +81,11 @@ private:
                    TTF_Font* font, SDL_Color color, bool centered);
     
     // Utility functions
-    void initClouds();
     float easeInOutCubic(float t);
     SDL_Color lerpColor(SDL_Color a, SDL_Color b, float t);
     
     // Member variables
     std::vector<MenuItem> items;
-    std::vector<Cloud> clouds;
     int selectedItem;
     
     TTF_Font* titleFont;
@@ -90,6 +102,17 @@ private:
     int windowWidth;
     int windowHeight;
     
+    // Shapes are batched per frame instead of drawn one call at a time
+    RenderBatch batch;
+    SkyLayer skyLayer;
+    ParallaxLayers parallax;
+    float cloudScroll; // Pretend camera position; the clouds drift by it
+    SDL_Texture* staticLayer;
+    SDL_Texture* selectedButton;
+    bool staticLayerFailed; // No render targets; draw everything each frame
+    bool showRenderStats;
+    bool loading;
+    
     static constexpr int KEY_REPEAT_DELAY = 150;
 };
 
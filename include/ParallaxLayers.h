@@ -0,0 +1,62 @@
+#ifndef PARALLAXLAYERS_H
+#define PARALLAXLAYERS_H
+
+#include <SDL2/SDL.h>
+
+enum class ParallaxKind {
+  STARS,       // Faint star field, shown at night
+  FAR_CLOUDS,  // Small, slow clouds high up
+  HILLS,       // Two ridges of hills standing on the ground line
+  NEAR_CLOUDS, // The big clouds
+  COUNT
+};
+
+// Scrolling background layers, back to front in ParallaxKind order.
+// Each layer is baked once into a texture whose content wraps around
+// horizontally and is at least as wide as the view, so drawing a layer at
+// any camera position takes at most two SDL_RenderCopy calls. If render
+// targets are not available the layers fall back to being drawn directly.
+class ParallaxLayers {
+public:
+  ParallaxLayers();
+  ~ParallaxLayers();
+
+  // (Re)create the layer textures for a view of this size. Also call
+  // after SDL_RENDER_TARGETS_RESET.
+  bool bake(SDL_Renderer *renderer, int viewWidth, int viewHeight);
+  void release();
+
+  bool isBaked() const { return viewWidth > 0; }
+
+  // Draws `kind` for a camera at cameraX; the layer scrolls at its own
+  // fraction of the camera speed. brightness and alpha are applied as
+  // color and alpha modulation (day-night tint, star fade).
+  void draw(SDL_Renderer *renderer, ParallaxKind kind, float cameraX,
+            Uint8 brightness = 255, Uint8 alpha = 255);
+
+  // Scroll speed of `kind` relative to the camera
+  static float scrollFactor(ParallaxKind kind);
+
+private:
+  struct Layer {
+    SDL_Texture *texture;
+    int period; // Width after which the layer's content repeats
+    int width;  // Texture width: a multiple of period, >= view width
+    int y, height;
+  };
+
+  ParallaxLayers(const ParallaxLayers &) = delete;
+  ParallaxLayers &operator=(const ParallaxLayers &) = delete;
+
+  // Immediate-mode layer art for one texture width at (originX, originY),
+  // used for baking and as the fallback path
+  static void drawLayer(SDL_Renderer *renderer, ParallaxKind kind,
+                        const Layer &layer, int originX, int originY,
+                        Uint8 brightness, Uint8 alpha);
+
+  Layer layers[static_cast<int>(ParallaxKind::COUNT)];
+  int viewWidth;
+  int viewHeight;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+class RenderBatch;
+
+// Frame profiler built on SDL_GetPerformanceCounter.
+// Code is timed with ProfileZone (usually through PROFILE_ZONE); every
+// zone's time is summed per frame, and the last HISTORY_FRAMES frames
+// give the averages and p99 shown by the overlay. The last TRACE_CAPACITY
+// zone samples are kept as trace events for exportChromeTrace(), which
+// writes a file for chrome://tracing or ui.perfetto.dev.
+//
+// Main thread only.
+class Profiler {
+public:
+  static const int HISTORY_FRAMES = 120; // Averages and p99
+  static const int GRAPH_FRAMES = 240;   // Frame time graph
+  static const int TRACE_CAPACITY = 1 << 16;
+
+  static Profiler &instance();
+
+  // Frame boundary: closes the current frame and starts the next one.
+  // Call once at the top of every frame loop.
+  void frame();
+
+  void record(const char *name, Uint64 start, Uint64 end);
+
+  // Overlay toggled with F4, shared by the menu and the game
+  void toggleOverlay() { overlayVisible = !overlayVisible; }
+  bool isOverlayVisible() const { return overlayVisible; }
+
+  // Zone table and frame time graph with the top left corner at (x, y)
+  void drawOverlay(RenderBatch &batch, TTF_Font *font, int x, int y);
+
+  // Write the recorded trace events as Chrome trace JSON
+  bool exportChromeTrace(const std::string &path) const;
+
+private:
+  struct Zone {
+    const char *name;
+    Uint64 frameTicks; // Time spent in this zone during the current frame
+    float history[HISTORY_FRAMES]; // ms per frame
+  };
+
+  struct TraceEvent {
+    const char *name;
+    Uint64 start, end;
+  };
+
+  Profiler();
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  Zone &findZone(const char *name);
+  double toMs(Uint64 ticks) const;
+
+  // Average and 99th percentile of the valid part of `history`
+  void summarize(const float *history, float *average, float *p99);
+
+  double frequency;
+  Uint64 frameStart;
+  Uint64 traceOrigin;
+  int frameCount;
+
+  std::vector<Zone> zones;
+  float frameHistory[GRAPH_FRAMES]; // ms, ring indexed by frameCount
+
+  std::vector<TraceEvent> trace; // Ring of TRACE_CAPACITY events
+  size_t traceNext;
+  bool traceWrapped;
+
+  bool overlayVisible;
+  std::vector<float> sortScratch;
+};
+
+// Times the enclosing scope, or up to end() if that comes first
+class ProfileZone {
+public:
+  explicit ProfileZone(const char *name)
+      : name(name), start(SDL_GetPerformanceCounter()), open(true) {}
+  ~ProfileZone() { end(); }
+
+  void end() {
+    if (open) {
+      Profiler::instance().record(name, start, SDL_GetPerformanceCounter());
+      open = false;
+    }
+  }
+
+private:
+  ProfileZone(const ProfileZone &) = delete;
+  ProfileZone &operator=(const ProfileZone &) = delete;
+
+  const char *name; // Must be a string literal (stored by pointer)
+  Uint64 start;
+  bool open;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+
+#endif
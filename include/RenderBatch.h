@@ -0,0 +1,64 @@
+#ifndef RENDERBATCH_H
+#define RENDERBATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Per-frame batcher for untextured primitives.
+// Mirrors the SDL draw API (a current color plus fill/outline/line calls)
+// but only records the shapes. flush() submits everything recorded so far
+// as one SDL_RenderGeometry call, or, on SDL older than 2.0.18, as one
+// SDL_RenderFillRects call per run of same-colored rects.
+//
+// Anything drawn straight through SDL (textures, text) must be preceded by
+// flush() so that draw order is preserved.
+class RenderBatch {
+public:
+  struct Stats {
+    int batches;    // Submissions to the renderer
+    int vertices;   // Vertices submitted
+    int primitives; // Rects and lines recorded
+  };
+
+  RenderBatch();
+  explicit RenderBatch(SDL_Renderer *renderer);
+
+  void setRenderer(SDL_Renderer *renderer);
+  SDL_Renderer *getRenderer() const { return renderer; }
+
+  void setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+  void fillRect(const SDL_Rect &rect);
+  void drawRect(const SDL_Rect &rect); // 1px outline
+  void drawLine(int x0, int y0, int x1, int y1);
+
+  void flush();
+
+  // Close the frame: flush, publish its stats and reset the counters
+  void endFrame();
+
+  const Stats &getFrameStats() const { return lastFrame; }
+
+private:
+  struct Primitive {
+    SDL_Rect rect; // Line: x, y = start, w, h = end
+    SDL_Color color;
+    bool isLine;
+  };
+
+  void appendQuad(float x0, float y0, float x1, float y1, float x2, float y2,
+                  float x3, float y3, SDL_Color color);
+
+  SDL_Renderer *renderer;
+  SDL_Color color;
+  std::vector<Primitive> pending;
+
+  // Scratch buffers reused every flush
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  std::vector<SDL_Rect> rects;
+
+  Stats current;
+  Stats lastFrame;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef RESOURCEMANAGER_H
+#define RESOURCEMANAGER_H
+
+#include <SDL2/SDL_ttf.h>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+// Owns every font the game opens, shared by Game, Menu and GameBox.
+// Fonts are keyed by (path, point size) and reference counted: acquiring
+// a font that is already open is a map lookup, and releasing the last
+// reference keeps it open so the next acquire (restarting with R,
+// re-initializing the menu on F11) is free. Unreferenced fonts are only
+// closed by purgeUnused(), which runs when a game session ends, or by
+// shutdown().
+class ResourceManager {
+public:
+  static ResourceManager &instance();
+
+  // Initializes SDL_ttf once. Safe to call again.
+  bool init();
+
+  // Closes every font (and its glyph atlas) and shuts SDL_ttf down.
+  // Call before the renderer is destroyed.
+  void shutdown();
+
+  // Returns nullptr if the file can't be opened. Every non-null result
+  // must be handed back with releaseFont().
+  TTF_Font *acquireFont(const std::string &path, int size);
+
+  // The game's UI font at `size`, from the first font file that opens.
+  // The winning path is remembered, so the fallback search runs once.
+  TTF_Font *acquireUIFont(int size);
+
+  // Drop one reference; nullptr is ignored
+  void releaseFont(TTF_Font *font);
+
+  // Close fonts that nobody holds a reference to
+  void purgeUnused();
+
+private:
+  typedef std::pair<std::string, int> FontKey;
+
+  struct FontEntry {
+    TTF_Font *font;
+    int refCount;
+  };
+
+  ResourceManager() : ttfInitialized(false) {}
+  ResourceManager(const ResourceManager &) = delete;
+  ResourceManager &operator=(const ResourceManager &) = delete;
+
+  static void closeFont(TTF_Font *font);
+
+  bool ttfInitialized;
+  std::map<FontKey, FontEntry> fonts;
+  std::map<TTF_Font *, FontKey> keys;
+
+  // Files that failed to open, so fallbacks don't retry them
+  std::set<std::string> missingFiles;
+  std::string uiFontPath;
+};
+
+#endif
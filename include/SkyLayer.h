@@ -0,0 +1,64 @@
+#ifndef SKYLAYER_H
+#define SKYLAYER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+class RenderBatch;
+
+// Day-night sky shared by the menu and the game.
+// The sky gradient is a cached 1 pixel wide texture stretched over the
+// view, so drawing it is a single SDL_RenderCopy. It is only regenerated
+// when dayTime moves into another of DAY_STEPS steps or the view height
+// changes. Star positions and twinkle phases, and the sun's ray offsets,
+// are precomputed instead of calling sin/cos per star per frame.
+class SkyLayer {
+public:
+  static const int DAY_STEPS = 512; // Sky color updates per day cycle
+  static const int STAR_COUNT = 50;
+
+  SkyLayer();
+  ~SkyLayer();
+
+  // Sky for `dayTime` (0.0 = midnight, 0.5 = noon) over the top `height`
+  // rows of a `width` wide view
+  void drawSky(SDL_Renderer *renderer, float dayTime, int width, int height);
+
+  // Sun or moon on its arc across the view, and stars at night.
+  // timeMs drives the twinkling.
+  void drawCelestial(RenderBatch &batch, float dayTime, Uint32 timeMs,
+                     int width);
+
+  // Destroys the cached texture. Call before the renderer is destroyed.
+  void release();
+
+  // Color at the top of the sky
+  static SDL_Color skyColor(float dayTime);
+
+  // How visible the stars are: 0 by day, 1 at midnight
+  static float starAlpha(float dayTime);
+
+private:
+  struct Star {
+    int x, y;
+    int size;
+    float phase; // Twinkle phase offset in [0, 2pi)
+  };
+
+  SkyLayer(const SkyLayer &) = delete;
+  SkyLayer &operator=(const SkyLayer &) = delete;
+
+  bool updateTexture(SDL_Renderer *renderer, int step, int height);
+  void buildStars(int width);
+
+  SDL_Texture *texture;
+  SDL_Renderer *textureRenderer;
+  int cachedStep;
+  int cachedHeight;
+  std::vector<Uint32> pixels; // Upload buffer, one pixel per row
+
+  std::vector<Star> stars;
+  int starWidth; // View width the star table was built for
+};
+
+#endif
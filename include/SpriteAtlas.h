@@ -0,0 +1,97 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "GameBox.h"
+#include "RenderBatch.h"
+
+enum class SpriteId {
+  PLAYER,
+  ENEMY,
+  COIN,
+  SWORD,
+  POISON_MUSHROOM,
+  POWER_MUSHROOM,
+  EXTRA_LIFE,
+  COUNT
+};
+
+// Player frames: walk cycle by leg offset, then the single poses
+const int PLAYER_WALK_FRAMES = 7; // Leg offset -3 .. 3
+const int PLAYER_FRAME_AIR = PLAYER_WALK_FRAMES;
+const int PLAYER_FRAME_DYING = PLAYER_WALK_FRAMES + 1;
+
+// The game's sprites (player, enemies, items, coins) with all their
+// animation frames, baked once into a single atlas texture.
+// Each of these used to be 10-30 rect draws per entity per frame. Drawing
+// one now queues a single textured quad, and flush() submits every queued
+// quad as one SDL_RenderGeometry call (one SDL_RenderCopy per sprite on
+// SDL older than 2.0.18). If render targets are not available the sprites
+// fall back to being drawn directly into the RenderBatch.
+//
+// A sprite is placed by its anchor: the top-left of the entity's box, or
+// the center for coins. Frames may reach outside the box (the player's
+// cap) and may differ in size (the spinning coin).
+class SpriteAtlas {
+public:
+  static const int ATLAS_WIDTH = 512;
+  static const int ATLAS_HEIGHT = 256;
+
+  SpriteAtlas();
+  ~SpriteAtlas();
+
+  // (Re)create the atlas texture. Also call after SDL_RENDER_TARGETS_RESET.
+  bool bake(SDL_Renderer *renderer);
+  void release();
+
+  bool isBaked() const { return texture != nullptr; }
+
+  // Queue `frame` of `id` at anchor (x, y). Without an atlas the sprite is
+  // drawn into `batch` right away instead.
+  void draw(RenderBatch &batch, SpriteId id, int frame, int x, int y);
+
+  // Submit the queued sprites. Shapes pending in `batch` go first, so
+  // draw order is kept.
+  void flush(RenderBatch &batch);
+
+  static int frameCount(SpriteId id);
+
+  // Animation frame from entity state
+  static int playerFrame(bool onGround, bool dying, float animPhase);
+  static int enemyFrame(float vx);
+  static int coinFrame(float animPhase);
+  static SpriteId itemSprite(ItemType type);
+
+private:
+  struct Frame {
+    SDL_Rect src;          // Cell in the atlas
+    int offsetX, offsetY;  // Cell top-left relative to the anchor
+  };
+
+  struct Quad {
+    SDL_Rect src, dst;
+  };
+
+  SpriteAtlas(const SpriteAtlas &) = delete;
+  SpriteAtlas &operator=(const SpriteAtlas &) = delete;
+
+  // Immediate-mode sprite art, used for baking and as the fallback path
+  static void drawSprite(RenderBatch &batch, SpriteId id, int frame, int x,
+                         int y);
+
+  const Frame &frameOf(SpriteId id, int frame) const;
+
+  SDL_Texture *texture;
+  std::vector<Frame> frames;                   // All sprites, in id order
+  int firstFrame[static_cast<int>(SpriteId::COUNT)]; // Index into frames
+
+  std::vector<Quad> pending;
+
+  // Scratch buffers reused every flush
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+};
+
+#endif
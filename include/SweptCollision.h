@@ -0,0 +1,43 @@
+#ifndef SWEPTCOLLISION_H
+#define SWEPTCOLLISION_H
+
+#include <vector>
+
+#include "GameBox.h"
+
+// Continuous (swept) AABB collision.
+// Instead of moving first and pushing back out of whatever the box ended
+// up inside, the move is traced from the start position and stops at the
+// first contact, so nothing tunnels through thin platforms however far it
+// moves in one step. Touching is not overlapping: a box resting on top of
+// a platform can slide along it.
+
+struct AABB {
+  float x, y, w, h;
+};
+
+struct SweepHit {
+  float time;             // Fraction of the move done at contact, [0, 1)
+  float normalX, normalY; // Contact normal, pointing out of the solid
+};
+
+enum class SweepAxis { X, Y };
+
+// Result of moving a box along one axis through a set of platforms
+struct AxisSweep {
+  float position;     // x or y where the box stopped
+  Platform *platform; // First platform in the way, or nullptr
+};
+
+// Moves `box` by (dx, dy) against one static `solid`. Returns false when
+// the box does not touch it during the move, and also when the two
+// already overlap at the start (nothing to trace against).
+bool sweepAABB(const AABB &box, float dx, float dy, const AABB &solid,
+               SweepHit &hit);
+
+// Moves `box` by `delta` along one axis, stopping flush against the first
+// of `platforms` in the way. On ties the platform listed first wins.
+AxisSweep sweepAxis(const AABB &box, SweepAxis axis, float delta,
+                    const std::vector<Platform *> &platforms);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <map>
+#include <vector>
+
+// Shared glyph atlas cache for TTF text.
+// Each font is rasterized once into a white glyph atlas texture. Strings
+// are then drawn as one batch of textured quads tinted with the requested
+// color, so changing text (score digits, "+50" popups) costs no
+// rasterization and no texture upload.
+class TextCache {
+public:
+  static TextCache &instance();
+
+  // Draw `text` with its top edge at y. When centered, x is the horizontal
+  // center of the string, otherwise its left edge.
+  void renderText(SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                  int x, int y, SDL_Color color, bool centered);
+
+  // Size of `text` as renderText would draw it
+  void measureText(SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                   int *w, int *h);
+
+  // Must be called before TTF_CloseFont on a font that was drawn with
+  void releaseFont(TTF_Font *font);
+
+  // Destroys all atlas textures. Call before the renderer is destroyed.
+  void clear();
+
+private:
+  static const int FIRST_GLYPH = 32;  // ' '
+  static const int LAST_GLYPH = 126;  // '~'
+  static const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+  static const int ATLAS_COLUMNS = 16;
+
+  struct GlyphAtlas {
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    int width, height;
+    int lineHeight;
+    SDL_Rect glyphs[GLYPH_COUNT];
+    int advance[GLYPH_COUNT];
+  };
+
+  TextCache() {}
+  TextCache(const TextCache &) = delete;
+  TextCache &operator=(const TextCache &) = delete;
+
+  GlyphAtlas *getAtlas(SDL_Renderer *renderer, TTF_Font *font);
+  bool buildAtlas(SDL_Renderer *renderer, TTF_Font *font, GlyphAtlas &atlas);
+  static int glyphIndex(char c);
+
+  std::map<TTF_Font *, GlyphAtlas> atlases;
+
+  // Scratch buffers reused across calls
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TILEGRID_H
+#define TILEGRID_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "GameBox.h"
+
+// Uniform grid over the static platforms of a level.
+// Every cell stores the indices of the platforms that overlap it, so a
+// collision query only visits the cells under the queried rectangle
+// instead of walking the whole platform list.
+class TileGrid {
+public:
+  TileGrid();
+
+  // Rebuild the grid from scratch. Indices refer to `platforms`.
+  // originX is the world x of the first column, so a grid can cover just
+  // one slice of the level.
+  void build(const std::vector<Platform> &platforms, int cellSize,
+             int originX = 0);
+  void clear();
+
+  // Append the indices of all platforms whose cells overlap `area`.
+  // Results are sorted and unique, so callers visit platforms in the same
+  // order as the original vector.
+  void query(const SDL_Rect &area, std::vector<int> &out) const;
+
+  int getCellSize() const { return cellSize; }
+  int getOriginX() const { return originX; }
+  int getColumns() const { return columns; }
+  int getRows() const { return rows; }
+
+private:
+  int originX;
+  int cellSize;
+  int columns;
+  int rows;
+
+  // Compact cell storage: indices of cell c live in
+  // entries[cellStart[c] .. cellStart[c + 1])
+  std::vector<int> cellStart;
+  std::vector<int> entries;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef TILESTRIPS_H
+#define TILESTRIPS_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+#include "LevelStreamer.h"
+#include "TileTextures.h"
+
+// Level geometry pre-rendered in strips, one per level chunk (512px wide,
+// as tall as the view). Apart from '?' blocks the tiles of a chunk never
+// change, so a visible strip is one SDL_RenderCopy instead of one copy per
+// tile, and scrolling costs one or two copies per frame.
+// Strips are kept in a small LRU cache around the camera. A strip is only
+// rendered again after it was evicted, or when a block in its chunk was
+// hit (see LevelStreamer::getChunkRevision). Active '?' blocks bounce, so
+// they are left out of the strip and drawn on top every frame.
+//
+// The cache belongs to one world: chunk revisions start over with a new
+// one.
+class TileStrips {
+public:
+  // Cached strips beyond the ones that fit in the view, so walking back a
+  // little doesn't render anything again
+  static const int SPARE_STRIPS = 2;
+
+  TileStrips();
+  ~TileStrips();
+
+  // Draws the level tiles for a view whose left edge is world x originX
+  // (whole pixels, the same origin the sprites use). Returns false when
+  // render targets are not available; the caller then draws the tiles one
+  // by one, now and from then on.
+  bool draw(SDL_Renderer *renderer, TileTextures &tiles,
+            const LevelStreamer &streamer, int originX, int viewWidth,
+            int viewHeight, Uint32 currentTime);
+
+  // Drop all strips. Also call after SDL_RENDER_TARGETS_RESET.
+  void release();
+
+  // Which tile art a platform uses. groundY is the top of the ground.
+  static TileKind kindOf(const Platform &platform, int groundY);
+
+  // Vertical offset of active '?' blocks at `currentTime`
+  static int questionBounce(Uint32 currentTime);
+
+private:
+  struct Strip {
+    SDL_Texture *texture;
+    int chunkIndex; // -1 when unused
+    unsigned int revision;
+    Uint32 lastUsed; // Frame number, for LRU eviction; 0 when unused
+    std::vector<SDL_Rect> questionBlocks; // World rects, drawn on top
+  };
+
+  TileStrips(const TileStrips &) = delete;
+  TileStrips &operator=(const TileStrips &) = delete;
+
+  Strip *acquire(SDL_Renderer *renderer, TileTextures &tiles,
+                 const LevelChunk &chunk, unsigned int revision,
+                 int viewHeight);
+  bool render(SDL_Renderer *renderer, TileTextures &tiles,
+              const LevelChunk &chunk, int viewHeight, Strip &strip);
+
+  std::vector<Strip> strips;
+  Uint32 frame;
+  bool failed; // Render targets didn't work; stop trying
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TILETEXTURES_H
+#define TILETEXTURES_H
+
+#include <SDL2/SDL.h>
+
+enum class TileKind {
+  GROUND,   // Grass and dirt strip at the bottom of the level
+  BRICK,    // Floating brick platform
+  QUESTION, // Active '?' block
+  USED,     // '?' block after it was hit
+  COUNT
+};
+
+// Level tiles baked into textures once at level load.
+// The detailed tile art (grass blades, dirt dots, brick highlights and
+// mortar) used to be dozens of fill calls per tile per frame; after
+// baking, each tile is a single SDL_RenderCopy. If render targets are not
+// available the tiles fall back to being drawn directly.
+class TileTextures {
+public:
+  static const int GROUND_HEIGHT = 80;
+
+  TileTextures();
+  ~TileTextures();
+
+  // (Re)create all tile textures. Also call after SDL_RENDER_TARGETS_RESET.
+  bool bake(SDL_Renderer *renderer);
+  void release();
+
+  void draw(SDL_Renderer *renderer, TileKind kind, const SDL_Rect &dst);
+
+  // Immediate-mode tile art, used for baking and as the fallback path
+  static void drawTile(SDL_Renderer *renderer, TileKind kind,
+                       const SDL_Rect &rect);
+
+private:
+  TileTextures(const TileTextures &) = delete;
+  TileTextures &operator=(const TileTextures &) = delete;
+
+  SDL_Texture *textures[static_cast<int>(TileKind::COUNT)];
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "AssetLoader.h"
+
+AssetLoader::AssetLoader() : running(0), stopping(false) {}
+
+AssetLoader::~AssetLoader() { stop(); }
+
+void AssetLoader::submit(const Job &job) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!worker.joinable()) {
+    stopping = false;
+    worker = std::thread(&AssetLoader::workerMain, this);
+  }
+  jobs.push_back(job);
+  wake.notify_one();
+}
+
+int AssetLoader::finishPending() {
+  std::vector<Finalizer> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ready.swap(finished);
+  }
+
+  // Outside the lock: a finalizer may submit the next job
+  for (size_t i = 0; i < ready.size(); i++) {
+    if (ready[i])
+      ready[i]();
+  }
+  return static_cast<int>(ready.size());
+}
+
+bool AssetLoader::busy() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return running > 0 || !jobs.empty() || !finished.empty();
+}
+
+void AssetLoader::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    jobs.clear();
+    wake.notify_one();
+  }
+  if (worker.joinable())
+    worker.join();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  finished.clear();
+}
+
+void AssetLoader::workerMain() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+    if (stopping)
+      return;
+
+    Job job = jobs.front();
+    jobs.pop_front();
+    running++;
+
+    lock.unlock();
+    Finalizer finalizer = job();
+    lock.lock();
+
+    running--;
+    finished.push_back(finalizer);
+  }
+}
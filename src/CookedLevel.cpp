@@ -0,0 +1,349 @@
+#include "CookedLevel.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char COOKED_MAGIC[8] = {'G', 'A', 'M', 'W', 'L', 'V', 'L', '\0'};
+
+static uint32_t alignTo4(size_t value) {
+  return static_cast<uint32_t>((value + 3) & ~static_cast<size_t>(3));
+}
+
+static bool endsWith(const std::string &text, const std::string &suffix) {
+  return text.size() >= suffix.size() &&
+         text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+CookedLevel::CookedLevel()
+    : header(nullptr), tiles(nullptr), coins(nullptr), enemies(nullptr),
+      mapping(nullptr), mappingSize(0) {
+#ifdef _WIN32
+  fileHandle = nullptr;
+  mappingHandle = nullptr;
+#endif
+}
+
+CookedLevel::~CookedLevel() { close(); }
+
+void CookedLevel::close() {
+  header = nullptr;
+  tiles = nullptr;
+  coins = nullptr;
+  enemies = nullptr;
+  owned.clear();
+
+#ifdef _WIN32
+  if (mapping)
+    UnmapViewOfFile(mapping);
+  if (mappingHandle)
+    CloseHandle(mappingHandle);
+  if (fileHandle)
+    CloseHandle(fileHandle);
+  fileHandle = nullptr;
+  mappingHandle = nullptr;
+#else
+  if (mapping)
+    munmap(mapping, mappingSize);
+#endif
+  mapping = nullptr;
+  mappingSize = 0;
+}
+
+bool CookedLevel::open(const std::string &path) {
+  if (endsWith(path, ".lvl"))
+    return openCooked(path);
+  return openText(path);
+}
+
+bool CookedLevel::openCooked(const std::string &path) {
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    std::cout << "Cannot open level: " << path << std::endl;
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    std::cout << "Empty level file: " << path << std::endl;
+    return false;
+  }
+  HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void *data = view ? MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!data) {
+    if (view)
+      CloseHandle(view);
+    CloseHandle(file);
+    std::cout << "Cannot map level: " << path << std::endl;
+    return false;
+  }
+  fileHandle = file;
+  mappingHandle = view;
+  mapping = data;
+  mappingSize = static_cast<size_t>(size.QuadPart);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cout << "Cannot open level: " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    std::cout << "Empty level file: " << path << std::endl;
+    return false;
+  }
+  void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping stays valid without the descriptor
+  if (data == MAP_FAILED) {
+    std::cout << "Cannot map level: " << path << std::endl;
+    return false;
+  }
+  mapping = data;
+  mappingSize = static_cast<size_t>(info.st_size);
+#endif
+
+  if (!attach(static_cast<const unsigned char *>(mapping), mappingSize,
+              path)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool CookedLevel::openText(const std::string &path) {
+  std::vector<std::string> rows;
+  if (!readTextRows(path, rows)) {
+    std::cout << "Cannot open level: " << path << std::endl;
+    return false;
+  }
+  return openRows(rows);
+}
+
+bool CookedLevel::openRows(const std::vector<std::string> &rows) {
+  close();
+  if (!cook(rows, owned) ||
+      !attach(owned.data(), owned.size(), "<memory>")) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// Every entity inside the level, sorted by column
+template <typename T>
+static bool entitiesValid(const T *list, uint32_t count, uint32_t columns,
+                          uint32_t rows) {
+  for (uint32_t i = 0; i < count; i++) {
+    if (list[i].column >= columns || list[i].row >= rows)
+      return false;
+    if (i > 0 && list[i].column < list[i - 1].column)
+      return false;
+  }
+  return true;
+}
+
+bool CookedLevel::attach(const unsigned char *data, size_t size,
+                         const std::string &path) {
+  if (size < sizeof(CookedLevelHeader)) {
+    std::cout << "Level file too small: " << path << std::endl;
+    return false;
+  }
+
+  const CookedLevelHeader *h =
+      reinterpret_cast<const CookedLevelHeader *>(data);
+  if (memcmp(h->magic, COOKED_MAGIC, sizeof(COOKED_MAGIC)) != 0 ||
+      h->version != COOKED_LEVEL_VERSION) {
+    std::cout << "Not a cooked level (or wrong version): " << path
+              << std::endl;
+    return false;
+  }
+
+  // Every section must lie inside the file
+  size_t tileBytes = static_cast<size_t>(h->columns) * h->rows;
+  bool valid =
+      h->fileSize == size && h->rows > 0 && h->columns > 0 &&
+      h->tilesOffset >= sizeof(CookedLevelHeader) &&
+      h->tilesOffset + tileBytes <= size &&
+      h->coinsOffset % 4 == 0 &&
+      h->coinsOffset + h->coinCount * sizeof(CookedCoin) <= size &&
+      h->enemiesOffset % 4 == 0 &&
+      h->enemiesOffset + h->enemyCount * sizeof(CookedEnemy) <= size;
+  if (!valid) {
+    std::cout << "Corrupt cooked level: " << path << std::endl;
+    return false;
+  }
+
+  // findCoins/findEnemies binary-search on column, and the streamer
+  // indexes tiles by entity position
+  const CookedCoin *coinList =
+      reinterpret_cast<const CookedCoin *>(data + h->coinsOffset);
+  const CookedEnemy *enemyList =
+      reinterpret_cast<const CookedEnemy *>(data + h->enemiesOffset);
+  if (!entitiesValid(coinList, h->coinCount, h->columns, h->rows) ||
+      !entitiesValid(enemyList, h->enemyCount, h->columns, h->rows)) {
+    std::cout << "Corrupt cooked level (entities): " << path << std::endl;
+    return false;
+  }
+
+  header = h;
+  tiles = reinterpret_cast<const char *>(data + h->tilesOffset);
+  coins = coinList;
+  enemies = enemyList;
+  return true;
+}
+
+template <typename T>
+static const T *findColumns(const T *begin, const T *end, int firstColumn,
+                            int lastColumn, size_t *count) {
+  struct ByColumn {
+    bool operator()(const T &entity, int column) const {
+      return entity.column < column;
+    }
+  };
+  const T *first = std::lower_bound(begin, end, firstColumn, ByColumn());
+  const T *last = std::lower_bound(first, end, lastColumn, ByColumn());
+  *count = static_cast<size_t>(last - first);
+  return first;
+}
+
+const CookedCoin *CookedLevel::findCoins(int firstColumn, int lastColumn,
+                                         size_t *count) const {
+  return findColumns(coins, coins + header->coinCount, firstColumn,
+                     lastColumn, count);
+}
+
+const CookedEnemy *CookedLevel::findEnemies(int firstColumn, int lastColumn,
+                                            size_t *count) const {
+  return findColumns(enemies, enemies + header->enemyCount, firstColumn,
+                     lastColumn, count);
+}
+
+bool CookedLevel::readTextRows(const std::string &path,
+                               std::vector<std::string> &rows) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file)
+    return false;
+
+  rows.clear();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line[line.size() - 1] == '\r')
+      line.erase(line.size() - 1);
+    if (!line.empty() && line[0] == '#')
+      continue;
+    rows.push_back(line);
+  }
+  return true;
+}
+
+bool CookedLevel::cook(const std::vector<std::string> &rows,
+                       std::vector<unsigned char> &out) {
+  CookedLevelHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC));
+  h.version = COOKED_LEVEL_VERSION;
+  h.playerColumn = -1;
+  h.playerRow = -1;
+
+  // Entity positions are stored in 16 bits and file offsets in 32;
+  // bigger levels would wrap. Each tile is one byte plus at most one
+  // entity.
+  size_t width = 0;
+  for (const std::string &line : rows)
+    width = std::max(width, line.size());
+  uint64_t worstSize =
+      sizeof(CookedLevelHeader) + 8 +
+      static_cast<uint64_t>(width) * rows.size() * (1 + sizeof(CookedEnemy));
+  if (rows.size() > COOKED_MAX_EXTENT || width > COOKED_MAX_EXTENT ||
+      worstSize > UINT32_MAX) {
+    std::cout << "Level too large to cook: " << width << "x" << rows.size()
+              << " tiles (at most " << COOKED_MAX_EXTENT
+              << " columns and rows, 4 GB cooked)" << std::endl;
+    return false;
+  }
+  h.rows = static_cast<uint32_t>(rows.size());
+  h.columns = static_cast<uint32_t>(width);
+
+  for (size_t row = 0; row < rows.size(); row++) {
+
+    // Same rule as the old parser: the last row with a 'P' wins
+    std::string::size_type col = rows[row].find('P');
+    if (col != std::string::npos) {
+      h.playerColumn = static_cast<int32_t>(col);
+      h.playerRow = static_cast<int32_t>(row);
+    }
+  }
+
+  std::vector<char> tileBytes(static_cast<size_t>(h.columns) * h.rows, ' ');
+  std::vector<CookedCoin> coinList;
+  std::vector<CookedEnemy> enemyList;
+
+  // Column-major walk, so entity lists come out sorted by column
+  for (uint32_t col = 0; col < h.columns; col++) {
+    for (uint32_t row = 0; row < h.rows; row++) {
+      const std::string &line = rows[row];
+      char tile = col < line.size() ? line[col] : ' ';
+
+      switch (tile) {
+      case 'G':
+      case 'B':
+      case '?':
+        tileBytes[col * h.rows + row] = tile;
+        break;
+      case 'C': {
+        CookedCoin coin = {static_cast<uint16_t>(col),
+                           static_cast<uint16_t>(row)};
+        coinList.push_back(coin);
+      } break;
+      case 'E':
+      case 'e': {
+        CookedEnemy enemy = {static_cast<uint16_t>(col),
+                             static_cast<uint16_t>(row),
+                             static_cast<uint8_t>(tile == 'E' ? 1 : 0), 0};
+        enemyList.push_back(enemy);
+      } break;
+      default:
+        break;
+      }
+    }
+  }
+
+  h.tilesOffset = sizeof(CookedLevelHeader);
+  h.coinCount = static_cast<uint32_t>(coinList.size());
+  h.coinsOffset = alignTo4(h.tilesOffset + tileBytes.size());
+  h.enemyCount = static_cast<uint32_t>(enemyList.size());
+  h.enemiesOffset =
+      alignTo4(h.coinsOffset + coinList.size() * sizeof(CookedCoin));
+  h.fileSize = static_cast<uint32_t>(h.enemiesOffset +
+                                     enemyList.size() * sizeof(CookedEnemy));
+
+  out.assign(h.fileSize, 0);
+  memcpy(out.data(), &h, sizeof(h));
+  if (!tileBytes.empty())
+    memcpy(out.data() + h.tilesOffset, tileBytes.data(), tileBytes.size());
+  if (!coinList.empty())
+    memcpy(out.data() + h.coinsOffset, coinList.data(),
+           coinList.size() * sizeof(CookedCoin));
+  if (!enemyList.empty())
+    memcpy(out.data() + h.enemiesOffset, enemyList.data(),
+           enemyList.size() * sizeof(CookedEnemy));
+  return true;
+}
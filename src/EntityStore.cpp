@@ -0,0 +1,188 @@
+#include "EntityStore.h"
+#include "EntityPool.h"
+#include <algorithm>
+#include <utility>
+
+#if !defined(GAMW_NO_SIMD) &&                                                 \
+    (defined(__SSE2__) || defined(_M_X64) ||                                  \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GAMW_SSE2 1
+#include <emmintrin.h>
+#endif
+
+void EnemyStore::add(float ex, float ey, float evx, int chunk, int index) {
+  x.push_back(ex);
+  y.push_back(ey);
+  vx.push_back(evx);
+  vy.push_back(0.0f);
+  prevX.push_back(ex);
+  prevY.push_back(ey);
+  spawnChunk.push_back(chunk);
+  spawnIndex.push_back(index);
+}
+
+void EnemyStore::addFrom(const EnemyStore &other, size_t i) {
+  std::ptrdiff_t at =
+      std::upper_bound(x.begin(), x.end(), other.x[i]) - x.begin();
+  x.insert(x.begin() + at, other.x[i]);
+  y.insert(y.begin() + at, other.y[i]);
+  vx.insert(vx.begin() + at, other.vx[i]);
+  vy.insert(vy.begin() + at, other.vy[i]);
+  prevX.insert(prevX.begin() + at, other.prevX[i]);
+  prevY.insert(prevY.begin() + at, other.prevY[i]);
+  spawnChunk.insert(spawnChunk.begin() + at, other.spawnChunk[i]);
+  spawnIndex.insert(spawnIndex.begin() + at, other.spawnIndex[i]);
+}
+
+void EnemyStore::remove(size_t i) {
+  orderedRemove(x, i);
+  orderedRemove(y, i);
+  orderedRemove(vx, i);
+  orderedRemove(vy, i);
+  orderedRemove(prevX, i);
+  orderedRemove(prevY, i);
+  orderedRemove(spawnChunk, i);
+  orderedRemove(spawnIndex, i);
+}
+
+void EnemyStore::clear() {
+  x.clear();
+  y.clear();
+  vx.clear();
+  vy.clear();
+  prevX.clear();
+  prevY.clear();
+  spawnChunk.clear();
+  spawnIndex.clear();
+}
+
+void EnemyStore::swapEntries(size_t a, size_t b) {
+  std::swap(x[a], x[b]);
+  std::swap(y[a], y[b]);
+  std::swap(vx[a], vx[b]);
+  std::swap(vy[a], vy[b]);
+  std::swap(prevX[a], prevX[b]);
+  std::swap(prevY[a], prevY[b]);
+  std::swap(spawnChunk[a], spawnChunk[b]);
+  std::swap(spawnIndex[a], spawnIndex[b]);
+}
+
+void EnemyStore::sortByX() {
+  for (size_t i = 1; i < x.size(); i++) {
+    for (size_t j = i; j > 0 && x[j] < x[j - 1]; j--) {
+      swapEntries(j, j - 1);
+    }
+  }
+}
+
+void CoinStore::add(float cx, float cy, int index) {
+  x.push_back(cx);
+  y.push_back(cy);
+  animPhase.push_back(0.0f);
+  spawnIndex.push_back(index);
+}
+
+void CoinStore::remove(size_t i) {
+  orderedRemove(x, i);
+  orderedRemove(y, i);
+  orderedRemove(animPhase, i);
+  orderedRemove(spawnIndex, i);
+}
+
+void CoinStore::clear() {
+  x.clear();
+  y.clear();
+  animPhase.clear();
+  spawnIndex.clear();
+}
+
+void advanceCoins(CoinStore &coins, float delta) {
+  size_t count = coins.size();
+  float *phase = coins.animPhase.data();
+  size_t i = 0;
+
+#ifdef GAMW_SSE2
+  const __m128 d = _mm_set1_ps(delta);
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(phase + i, _mm_add_ps(_mm_loadu_ps(phase + i), d));
+  }
+#endif
+
+  for (; i < count; i++) {
+    phase[i] += delta;
+  }
+}
+
+// Overlap test of entities [first, last)
+static void overlapsInRange(const std::vector<float> &xs,
+                            const std::vector<float> &ys, size_t first,
+                            size_t last, int offset, int size,
+                            const SDL_Rect &area, std::vector<int> &hits) {
+  if (area.w <= 0 || area.h <= 0 || size <= 0)
+    return;
+
+  const float *x = xs.data();
+  const float *y = ys.data();
+  int areaRight = area.x + area.w;
+  int areaBottom = area.y + area.h;
+  size_t i = first;
+
+#ifdef GAMW_SSE2
+  // Overlap on an axis: left < areaRight && areaLeft < left + size,
+  // i.e. left > areaLeft - size
+  const __m128i off = _mm_set1_epi32(offset);
+  const __m128i maxLeft = _mm_set1_epi32(areaRight);
+  const __m128i minLeft = _mm_set1_epi32(area.x - size);
+  const __m128i maxTop = _mm_set1_epi32(areaBottom);
+  const __m128i minTop = _mm_set1_epi32(area.y - size);
+  for (; i + 4 <= last; i += 4) {
+    __m128i left = _mm_add_epi32(_mm_cvttps_epi32(_mm_loadu_ps(x + i)), off);
+    __m128i top = _mm_add_epi32(_mm_cvttps_epi32(_mm_loadu_ps(y + i)), off);
+
+    __m128i hit = _mm_and_si128(_mm_cmplt_epi32(left, maxLeft),
+                                _mm_cmpgt_epi32(left, minLeft));
+    hit = _mm_and_si128(hit, _mm_cmplt_epi32(top, maxTop));
+    hit = _mm_and_si128(hit, _mm_cmpgt_epi32(top, minTop));
+
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(hit));
+    for (int lane = 0; mask != 0; lane++, mask >>= 1) {
+      if (mask & 1)
+        hits.push_back(static_cast<int>(i) + lane);
+    }
+  }
+#endif
+
+  for (; i < last; i++) {
+    int left = static_cast<int>(x[i]) + offset;
+    int top = static_cast<int>(y[i]) + offset;
+    if (left < areaRight && area.x < left + size && top < areaBottom &&
+        area.y < top + size) {
+      hits.push_back(static_cast<int>(i));
+    }
+  }
+}
+
+void findOverlaps(const std::vector<float> &xs, const std::vector<float> &ys,
+                  int offset, int size, const SDL_Rect &area,
+                  std::vector<int> &hits) {
+  overlapsInRange(xs, ys, 0, xs.size(), offset, size, area, hits);
+}
+
+void sortedRange(const std::vector<float> &xs, float minX, float maxX,
+                 size_t &first, size_t &last) {
+  first = static_cast<size_t>(
+      std::lower_bound(xs.begin(), xs.end(), minX) - xs.begin());
+  last = static_cast<size_t>(
+      std::upper_bound(xs.begin() + first, xs.end(), maxX) - xs.begin());
+}
+
+void findOverlapsSorted(const std::vector<float> &xs,
+                        const std::vector<float> &ys, int offset, int size,
+                        const SDL_Rect &area, std::vector<int> &hits) {
+  // int(x) + offset must lie in (area.x - size, area.x + area.w). The
+  // bounds are widened by a pixel for the truncation to int.
+  size_t first, last;
+  sortedRange(xs, static_cast<float>(area.x - size - offset - 1),
+              static_cast<float>(area.x + area.w - offset + 1), first, last);
+  overlapsInRange(xs, ys, first, last, offset, size, area, hits);
+}
@@ -0,0 +1,88 @@
+#include "FramePacer.h"
+
+FramePacer &FramePacer::instance() {
+  static FramePacer pacer;
+  return pacer;
+}
+
+FramePacer::FramePacer()
+    : lastInputTime(0), lastFrameTime(0), focused(true), minimized(false) {}
+
+void FramePacer::onEvent(const SDL_Event &event) {
+  switch (event.type) {
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+  case SDL_TEXTINPUT:
+  case SDL_MOUSEMOTION:
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+  case SDL_MOUSEWHEEL:
+  case SDL_FINGERDOWN:
+  case SDL_FINGERMOTION:
+  case SDL_CONTROLLERBUTTONDOWN:
+  case SDL_CONTROLLERAXISMOTION:
+    wake();
+    break;
+
+  case SDL_WINDOWEVENT:
+    switch (event.window.event) {
+    case SDL_WINDOWEVENT_FOCUS_GAINED:
+      focused = true;
+      wake();
+      break;
+    case SDL_WINDOWEVENT_FOCUS_LOST:
+      focused = false;
+      break;
+    case SDL_WINDOWEVENT_MINIMIZED:
+    case SDL_WINDOWEVENT_HIDDEN:
+      minimized = true;
+      break;
+    case SDL_WINDOWEVENT_RESTORED:
+    case SDL_WINDOWEVENT_SHOWN:
+    case SDL_WINDOWEVENT_EXPOSED:
+      minimized = false;
+      wake();
+      break;
+    }
+    break;
+  }
+}
+
+void FramePacer::wake() { lastInputTime = SDL_GetTicks(); }
+
+FramePacer::Mode FramePacer::mode(bool quiet) const {
+  if (minimized)
+    return Mode::MINIMIZED;
+  if (!focused)
+    return Mode::BACKGROUND;
+  if (quiet || SDL_GetTicks() - lastInputTime >= IDLE_AFTER_MS)
+    return Mode::IDLE;
+  return Mode::ACTIVE;
+}
+
+void FramePacer::waitForFrame(bool quiet) {
+  int fps = 0;
+  switch (mode(quiet)) {
+  case Mode::ACTIVE:
+    break;
+  case Mode::IDLE:
+    fps = IDLE_FPS;
+    break;
+  case Mode::BACKGROUND:
+    fps = BACKGROUND_FPS;
+    break;
+  case Mode::MINIMIZED:
+    fps = MINIMIZED_FPS;
+    break;
+  }
+
+  if (fps > 0) {
+    Uint32 due = lastFrameTime + 1000 / fps;
+    Uint32 now = SDL_GetTicks();
+    // Wraparound-safe "now < due"; an event ends the wait early and is
+    // left in the queue for the loop's own SDL_PollEvent
+    if (static_cast<Sint32>(due - now) > 0)
+      SDL_WaitEventTimeout(nullptr, static_cast<int>(due - now));
+  }
+  lastFrameTime = SDL_GetTicks();
+}
@@ -1,376 +1,136 @@
 #include "GameBox.h"
+#include "FramePacer.h"
+#include "GameSession.h"
+#include "GameWorld.h"
+#include "TextCache.h"
+#include "LevelStreamer.h"
+#include "Log.h"
+#include "ParallaxLayers.h"
+#include "Profiler.h"
+#include "RenderBatch.h"
+#include "SkyLayer.h"
+#include "SpriteAtlas.h"
+#include "TileStrips.h"
+#include "TileTextures.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <string>
 #include <vector>
 
-// Game constants
-const float GRAVITY = 1200.0f;
-const float JUMP_FORCE = -700.0f;
-const float MOVE_SPEED = 250.0f;
-const int PLAYER_SIZE = 32;
-const int TILE_SIZE = 32;
-
-// Camera offset - jarak player dari tepi kiri layar
-const int CAMERA_OFFSET_X = 200;
-
-// Item structure
-struct Item {
-  float x, y;
-  float vy; // Vertical velocity (for popping out animation)
-  ItemType type;
-  bool active;
-  bool collected;
-  Uint32 spawnTime;
-  SDL_Rect rect;
-};
-
-// Player buffs/debuffs
-struct PlayerStatus {
-  bool hasSword = false;     // Faster movement
-  bool isPoisoned = false;   // Slower movement
-  bool isInvincible = false; // Can't be hurt
-  Uint32 swordEndTime = 0;
-  Uint32 poisonEndTime = 0;
-  Uint32 invincibleEndTime = 0;
-};
-
-void renderText(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x,
+void renderText(RenderBatch &batch, TTF_Font *font, const char *text, int x,
                 int y, SDL_Color color, bool centered) {
   if (!font)
     return;
 
-  SDL_Surface *surface = TTF_RenderText_Solid(font, text, color);
-  if (surface) {
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect rect = {centered ? x - surface->w / 2 : x, y - surface->h / 2,
-                     surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, nullptr, &rect);
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
-  }
-}
-
-// ========================================
-// LEVEL DESIGN - BUAT LEVEL ANDA DI SINI!
-// ========================================
-// Legend:
-// ' ' = empty space
-// 'G' = ground/grass block
-// 'B' = brick block
-// '?' = question block (coin block)
-// 'C' = coin
-// 'E' = enemy (moving right)
-// 'e' = enemy (moving left)
-// 'P' = player start position
-//
-// CATATAN:
-// - Baris harus cukup banyak (minimal 20 baris) agar posisi block dan enemy
-// tepat
-// - Level bisa sepanjang yang Anda mau (horizontal)
-// - Player spawn di 'P'
-
-std::vector<std::string> mainLevel = {
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 0
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 1
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 2
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 3
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 4
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 5
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 6
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 7
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 8
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 9
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 10
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 11
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 12
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 13
-    "             ?           ?                      C   C   C                 "
-    "  ?       ?       ?                                                       "
-    "                     ", // Baris 14
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 15
-    "      C     BBBB         BBBB                       BBB                 "
-    "BBB   BBB   BBB                                         C                 "
-    "                       ", // Baris 16
-    "    BBBB                                                                  "
-    "                                                  BBBBBBBB                "
-    "                      ", // Baris 17
-    "                                                                          "
-    "                                                                          "
-    "                      ", // Baris 18
-    "  P            E              e                 E           e             "
-    "      E               e                       E                   e       "
-    "                    ", // Baris 19 - Ground level
-};
-
-// Function to parse level from string array
-void parseLevelFromArray(const std::vector<std::string> &levelData,
-                         std::vector<Platform> &platforms,
-                         std::vector<Coin> &coins, std::vector<Enemy> &enemies,
-                         float &playerStartX, float &playerStartY,
-                         int windowWidth, int windowHeight) {
-
-  // Clear existing data
-  platforms.clear();
-  coins.clear();
-  enemies.clear();
-
-  // Calculate level dimensions
-  int levelHeight = levelData.size();
-  int levelWidth = 0;
-  for (const auto &row : levelData) {
-    if (row.length() > levelWidth)
-      levelWidth = row.length();
-  }
-
-  // Ground level
-  int groundY = windowHeight - 80;
-
-  // Parse from top to bottom
-  for (int row = 0; row < levelHeight; row++) {
-    const std::string &line = levelData[row];
-
-    for (int col = 0; col < line.length(); col++) {
-      char tile = line[col];
-      int x = col * TILE_SIZE;
-      int y = row * TILE_SIZE;
-
-      switch (tile) {
-      case 'G': // Ground / Grass
-        platforms.push_back({{x, y, TILE_SIZE, TILE_SIZE}, false, true, false});
-        break;
-
-      case 'B': // Brick platform
-        platforms.push_back({{x, y, TILE_SIZE, TILE_SIZE}, false, true, false});
-        break;
-
-      case 'C': // Coin
-        coins.push_back({x + TILE_SIZE / 2, y + TILE_SIZE / 2, false, 0.0f});
-        break;
-
-      case 'E': // Enemy (moving right)
-      {
-        Enemy e;
-        e.x = static_cast<float>(x);
-        e.y = static_cast<float>(y);
-        e.vx = 50.0f; // Moving right
-        e.rect = {x, y, 28, 28};
-        e.active = true;
-        enemies.push_back(e);
-      } break;
-
-      case 'e': // Enemy (moving left)
-      {
-        Enemy e;
-        e.x = static_cast<float>(x);
-        e.y = static_cast<float>(y);
-        e.vx = -50.0f; // Moving left
-        e.rect = {x, y, 28, 28};
-        e.active = true;
-        enemies.push_back(e);
-      } break;
-
-      case 'P': // Player start position
-        playerStartX = static_cast<float>(x);
-        playerStartY = static_cast<float>(y);
-        break;
-      case '?': // Question block (coin block)
-      {
-        // Randomly assign an item type to this block
-        int randomItem = rand() % 4;
-        ItemType itemType;
-        switch (randomItem) {
-        case 0:
-          itemType = ItemType::SWORD;
-          break;
-        case 1:
-          itemType = ItemType::POISON_MUSHROOM;
-          break;
-        case 2:
-          itemType = ItemType::POWER_MUSHROOM;
-          break;
-        case 3:
-          itemType = ItemType::EXTRA_LIFE;
-          break;
-        }
-        platforms.push_back(
-            {{x, y, TILE_SIZE, TILE_SIZE}, true, false, false, itemType});
-      } break;
-      case ' ': // Empty space
-      default:
-        break;
-      }
-    }
-  }
+  // Text is textured, so pending shapes must go out first
+  batch.flush();
+  SDL_Renderer *renderer = batch.getRenderer();
 
-  // Add full ground at bottom
-  int levelWidthPixels = levelWidth * TILE_SIZE;
-  for (int x = 0; x < levelWidthPixels; x += TILE_SIZE) {
-    platforms.push_back({{x, groundY, TILE_SIZE, 80}, false, true, false});
-  }
+  // y is the vertical center of the text
+  TextCache &textCache = TextCache::instance();
+  int textH = 0;
+  textCache.measureText(renderer, font, text, nullptr, &textH);
+  textCache.renderText(renderer, font, text, x, y - textH / 2, color, centered);
 }
 
-bool runGameBox(SDL_Renderer *renderer) {
-  // Initialize TTF if not already initialized
-  static bool ttfInitialized = false;
-  std::vector<Item> items;
-  PlayerStatus playerStatus;
-
-  if (!ttfInitialized) {
-    if (TTF_Init() == -1) {
-      std::cout << "TTF_Init failed: " << TTF_GetError() << std::endl;
-    } else {
-      ttfInitialized = true;
-      std::cout << "TTF initialized successfully" << std::endl;
-    }
-  }
-
-  // Load font for UI
-  TTF_Font *gameFont = nullptr;
-  TTF_Font *smallFont = nullptr;
-  const char *font_paths[] = {
-      "assets/PressStart2P-Regular.ttf",
-      "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
-      "C:\\Windows\\Fonts\\arial.ttf"};
-
-  for (const char *path : font_paths) {
-    gameFont = TTF_OpenFont(path, 20);
-    smallFont = TTF_OpenFont(path, 16);
-    if (gameFont && smallFont) {
-      std::cout << "Fonts loaded successfully from: " << path << std::endl;
-      break;
-    } else {
-      std::cout << "Failed to load font from: " << path << std::endl;
-      if (TTF_GetError()) {
-        std::cout << "TTF Error: " << TTF_GetError() << std::endl;
-      }
-    }
-  }
-
-  if (!gameFont || !smallFont) {
-    std::cout << "WARNING: No fonts loaded! Text will not display."
-              << std::endl;
-    std::cout << "Make sure font files exist in one of the specified paths."
-              << std::endl;
-  }
+// One run of the session's world, until the player quits or restarts
+static bool playSession(SDL_Renderer *renderer, GameSession &session) {
+  // Loading and GPU uploads already happened (see GameSession), so the
+  // first frame goes out right away
+  GameWorld &world = *session.world;
+  TileTextures &tileTextures = session.tileTextures;
+  ParallaxLayers &parallax = session.parallax;
+  SpriteAtlas &sprites = session.sprites;
+  TTF_Font *gameFont = session.gameFont;
+  TTF_Font *smallFont = session.smallFont;
 
   // Get window size
   int windowWidth, windowHeight;
   SDL_GetRendererOutputSize(renderer, &windowWidth, &windowHeight);
 
-  // Player state
-  float playerX = 100.0f;
-  float playerY = 100.0f;
-  float playerStartX = 100.0f;
-  float playerStartY = 100.0f;
-  float velocityX = 0.0f;
-  float velocityY = 0.0f;
-  bool isOnGround = false;
-  bool facingRight = true;
-
-  // Camera position (world coordinate)
-  float cameraX = 0.0f;
-
-  // Calculate level width
-  int levelWidth = 0;
-  for (const auto &row : mainLevel) {
-    if (row.length() > levelWidth)
-      levelWidth = row.length();
-  }
-  int levelWidthPixels = levelWidth * TILE_SIZE;
-
-  // Game state
-  int score = 0;
-  int lives = 3;
-  bool gameOver = false;
-  bool levelComplete = false;
-  Uint32 deathTime = 0;
-  bool isDying = false;
-  Uint32 dyingStartTime = 0;
-  float deathFallVelocity = 0.0f;
-  int deathCount = 0;
-
-  // Animation
-  float animPhase = 0.0f;
-
-  // Day-Night Cycle (5 minutes = 300 seconds for full cycle)
-  const float DAY_CYCLE_DURATION = 300.0f; // 5 minutes in seconds
-  float dayTime = 0.0f; // 0.0 = midnight, 0.25 = sunrise, 0.5 = noon, 0.75 =
-                        // sunset, 1.0 = midnight
-  Uint32 gameStartTime = SDL_GetTicks();
-
-  // Floating texts
-  std::vector<FloatingText> floatingTexts;
-
-  // Game objects
-  std::vector<Platform> platforms;
-  std::vector<Coin> coins;
-  std::vector<Enemy> enemies;
-
-  // Parse level from array
-  parseLevelFromArray(mainLevel, platforms, coins, enemies, playerStartX,
-                      playerStartY, windowWidth, windowHeight);
-
-  // Set player to start position
-  playerX = playerStartX;
-  playerY = playerStartY;
+  // Untextured shapes are collected here and submitted in batches
+  RenderBatch batch(renderer);
+  SkyLayer skyLayer;
+  TileStrips tileStrips; // Per-world: chunk revisions restart with it
+  bool showRenderStats = false;
+
+  // Fixed timestep: the simulation always advances in SIM_STEP increments,
+  // whatever the display rate. Rendering interpolates between the previous
+  // and the current step using the time left in the accumulator.
+  const double SIM_STEP = 1.0 / 120.0;
+  const double MAX_FRAME_TIME = 0.25; // Drop time instead of spiralling
+  double accumulator = 0.0;
+  bool jumpQueued = false;
 
   SDL_Event event;
   bool running = true;
-  Uint32 lastTime = SDL_GetTicks();
+  const double counterFrequency =
+      static_cast<double>(SDL_GetPerformanceFrequency());
+  Uint64 lastCounter = SDL_GetPerformanceCounter();
 
-  std::cout << "=== Cat Mario Style Game Started ===" << std::endl;
-  std::cout << "Level loaded: " << platforms.size() << " platforms, "
-            << coins.size() << " coins, " << enemies.size() << " enemies"
-            << std::endl;
-  std::cout << "Level width: " << levelWidthPixels << " pixels" << std::endl;
-  std::cout << "Controls: A/D = Move, Space/W = Jump" << std::endl;
+  LOG_INFO("=== Cat Mario Style Game Started ===");
+  LOG_INFO("Level loaded: %d chunks of %d columns",
+           world.streamer.getChunkCount(), LevelStreamer::CHUNK_COLUMNS);
+  LOG_INFO("Level width: %d pixels", world.levelWidthPixels);
+  LOG_INFO("Controls: A/D = Move, Space/W = Jump");
+
+  Profiler &profiler = Profiler::instance();
+  FramePacer &pacer = FramePacer::instance();
+  const bool recording = session.replayMode == ReplayMode::RECORD;
+  const bool replaying = session.replayMode == ReplayMode::PLAY;
 
   while (running) {
-    // Calculate delta time
-    Uint32 currentTime = SDL_GetTicks();
-    float deltaTime = (currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
+    // The game over and level complete screens are static, and nothing
+    // needs drawing while minimized: sleep between frames there. Active
+    // play stays at full rate, and replays always run flat out.
+    const bool quiet = world.gameOver || world.levelComplete;
+    if (!replaying && (quiet || pacer.isMinimized())) {
+      pacer.waitForFrame(quiet);
+    }
+
+    profiler.frame();
 
-    if (deltaTime > 0.05f)
-      deltaTime = 0.05f;
+    // Measure real time and feed it to the accumulator. A replay brings
+    // its own frame times, so the steps land on the same frames as when
+    // it was recorded.
+    double frameTime;
+    int replaySteps = 0;
+    if (replaying) {
+      if (!session.replay.nextFrame(&frameTime, &replaySteps)) {
+        LOG_INFO("Replay finished");
+        return false;
+      }
+    } else {
+      Uint64 nowCounter = SDL_GetPerformanceCounter();
+      frameTime = (nowCounter - lastCounter) / counterFrequency;
+      lastCounter = nowCounter;
+
+      if (frameTime > MAX_FRAME_TIME)
+        frameTime = MAX_FRAME_TIME;
+    }
+    if (recording)
+      session.replay.recordFrame(frameTime);
+    accumulator += frameTime;
 
     // ------- EVENTS -------
+    ProfileZone inputZone("input");
     while (SDL_PollEvent(&event)) {
-      if (event.type == SDL_QUIT)
+      pacer.onEvent(event);
+
+      // Render target contents are lost on some device resets
+      if (event.type == SDL_RENDER_TARGETS_RESET) {
+        tileTextures.bake(renderer);
+        parallax.bake(renderer, windowWidth, windowHeight);
+        sprites.bake(renderer);
+        tileStrips.release();
+        session.renderTargetsReset = true;
+      }
+
+      if (event.type == SDL_QUIT) {
         return false;
+      }
 
       if (event.type == SDL_KEYDOWN) {
         switch (event.key.keysym.sym) {
@@ -379,13 +139,20 @@ bool runGameBox(SDL_Renderer *renderer) {
         case SDLK_SPACE:
         case SDLK_UP:
         case SDLK_w:
-          if (isOnGround && !gameOver && !levelComplete) {
-            velocityY = JUMP_FORCE;
-            isOnGround = false;
-          }
+          // Applied by the next simulation step
+          jumpQueued = true;
+          break;
+        case SDLK_F3:
+          showRenderStats = !showRenderStats;
+          break;
+        case SDLK_F4:
+          profiler.toggleOverlay();
+          break;
+        case SDLK_F5:
+          profiler.exportChromeTrace("gamw_trace.json");
           break;
         case SDLK_r:
-          if (gameOver || levelComplete) {
+          if (world.gameOver || world.levelComplete) {
             return true; // Restart
           }
           break;
@@ -393,998 +160,203 @@ bool runGameBox(SDL_Renderer *renderer) {
       }
     }
 
-    if (!gameOver && !levelComplete) {
-      float elapsedTime = (currentTime - gameStartTime) / 1000.0f;
-      dayTime = fmod(elapsedTime / DAY_CYCLE_DURATION, 1.0f);
-      // ------- INPUT -------
-      const Uint8 *keystate = SDL_GetKeyboardState(NULL);
-      velocityX = 0.0f;
-
-      // Only allow input if not dying
-      if (!isDying) {
-        if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A]) {
-          float speed = MOVE_SPEED;
-          if (playerStatus.hasSword)
-            speed *= 1.5f; // 50% faster
-          if (playerStatus.isPoisoned)
-            speed *= 0.5f; // 50% slower
-          velocityX = -speed;
-          facingRight = false;
-        }
-        if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
-          float speed = MOVE_SPEED;
-          if (playerStatus.hasSword)
-            speed *= 1.5f;
-          if (playerStatus.isPoisoned)
-            speed *= 0.5f;
-          velocityX = speed;
-          facingRight = true;
-        }
-      }
-
-      // ------- PHYSICS -------
-      // Handle death animation
-      if (isDying) {
-        Uint32 timeSinceDeath = currentTime - dyingStartTime;
-
-        // Phase 1: Freeze for 500ms
-        if (timeSinceDeath < 500) {
-          velocityX = 0.0f;
-          velocityY = 0.0f;
-        }
-        // Phase 2: Fall down (500ms - 2000ms)
-        else if (timeSinceDeath < 2000) {
-          velocityX = 0.0f;
-          deathFallVelocity += GRAVITY * deltaTime * 0.5f;
-          playerY += deathFallVelocity * deltaTime;
-        }
-        // Phase 3: Show death screen (2000ms - 4000ms)
-        else if (timeSinceDeath < 4000) {
-          // Just wait, death screen is shown
-        }
-        // Phase 4: Respawn
-        else {
-          if (lives <= 0) {
-            gameOver = true;
-            deathTime = currentTime;
-            std::cout << "Game Over! Final Score: " << score << std::endl;
-          } else {
-            // Respawn player
-            isDying = false;
-            playerX = playerStartX;
-            playerY = playerStartY;
-            velocityX = 0.0f;
-            velocityY = 0.0f;
-            deathFallVelocity = 0.0f;
-            cameraX = 0.0f;
-          }
-        }
-
-        // Skip normal physics when dying
-        if (isDying) {
-          // Continue to rendering
-          goto skip_normal_physics;
-        }
-      }
-
-      velocityY += GRAVITY * deltaTime;
-      if (velocityY > 600.0f)
-        velocityY = 600.0f;
-
-      float oldX = playerX;
-      float oldY = playerY;
-
-      playerX += velocityX * deltaTime;
-      playerY += velocityY * deltaTime;
-
-      // ===== BATAS KIRI - Player tidak bisa mundur melewati camera =====
-      float minPlayerX = cameraX + 50.0f; // 50px dari tepi kiri layar
-      if (playerX < minPlayerX) {
-        playerX = minPlayerX;
-      }
-
-      // ===== UPDATE CAMERA - Smooth follow player =====
-      float targetCameraX = playerX - CAMERA_OFFSET_X;
-      if (targetCameraX > cameraX) {
-        cameraX = targetCameraX;
-      }
-
-      // Batas kamera tidak melewati level
-      if (cameraX < 0)
-        cameraX = 0;
-      if (cameraX > levelWidthPixels - windowWidth) {
-        cameraX = levelWidthPixels - windowWidth;
-      }
-
-      // Check level complete
-      if (playerX >= levelWidthPixels - 100) {
-        levelComplete = true;
-        std::cout << "=== LEVEL COMPLETE! ===" << std::endl;
-        std::cout << "Final Score: " << score << std::endl;
-      }
-
-      SDL_Rect playerRect = {static_cast<int>(playerX),
-                             static_cast<int>(playerY), PLAYER_SIZE,
-                             PLAYER_SIZE};
-
-      // ===== COLLISION WITH PLATFORMS =====
-      isOnGround = false;
-
-      for (auto &platform : platforms) {
-        bool overlapsX = playerX + PLAYER_SIZE > platform.rect.x &&
-                         playerX < platform.rect.x + platform.rect.w;
-        bool overlapsY = playerY + PLAYER_SIZE > platform.rect.y &&
-                         playerY < platform.rect.y + platform.rect.h;
-
-        if (overlapsX && overlapsY) {
-          if (oldY + PLAYER_SIZE <= platform.rect.y && velocityY > 0) {
-            playerY = platform.rect.y - PLAYER_SIZE;
-            velocityY = 0;
-            isOnGround = true;
-          } else if (oldY >= platform.rect.y + platform.rect.h &&
-                     velocityY < 0) {
-            playerY = platform.rect.y + platform.rect.h;
-            velocityY = 0;
-
-            if (platform.isBreakable && !platform.isHit) {
-              platform.isHit = true;
-              std::cout << "Block hit!" << std::endl;
-
-              // Create item instead of score
-              Item newItem;
-              newItem.x = platform.rect.x + platform.rect.w / 2.0f;
-              newItem.y = platform.rect.y - 32;
-              newItem.vy = -200.0f; // Pop up velocity
-              newItem.type = platform.containedItem;
-              newItem.active = true;
-              newItem.collected = false;
-              newItem.spawnTime = currentTime;
-              newItem.rect = {static_cast<int>(newItem.x) - 16,
-                              static_cast<int>(newItem.y), 32, 32};
-              items.push_back(newItem);
-
-              // Show what item appeared
-              const char *itemNames[] = {"SWORD", "POISON", "POWER", "LIFE"};
-              std::cout << "Item spawned: "
-                        << itemNames[static_cast<int>(newItem.type)]
-                        << std::endl;
-            }
-          } else if (velocityY >= 0) {
-            if (oldX + PLAYER_SIZE <= platform.rect.x) {
-              playerX = platform.rect.x - PLAYER_SIZE;
-            } else if (oldX >= platform.rect.x + platform.rect.w) {
-              playerX = platform.rect.x + platform.rect.w;
-            }
-          }
-        }
-      }
-
-      playerRect.x = static_cast<int>(playerX);
-      playerRect.y = static_cast<int>(playerY);
-
-      // Coin collection
-      SDL_Rect coinCollect = {playerRect.x + 4, playerRect.y + 4,
-                              playerRect.w - 8, playerRect.h - 8};
-      for (auto &coin : coins) {
-        if (!coin.collected) {
-          SDL_Rect coinRect = {coin.x - 8, coin.y - 8, 16, 16};
-          if (SDL_HasIntersection(&coinCollect, &coinRect)) {
-            coin.collected = true;
-            score += 50;
-            std::cout << "Coin collected! Score: " << score << std::endl;
-
-            // Create floating text for coin
-            FloatingText ft;
-            ft.x = coin.x;
-            ft.y = coin.y - 10.0f;
-            ft.vy = -80.0f;
-            ft.value = 50;
-            ft.spawnTime = currentTime;
-            ft.active = true;
-            floatingTexts.push_back(ft);
-          }
-        }
-      }
-
-      // Update floating texts
-      for (auto &ft : floatingTexts) {
-        if (!ft.active)
-          continue;
+    // The keyboard state only changes when events are pumped, so one read
+    // serves every step of this frame
+    const Uint8 *keystate = SDL_GetKeyboardState(NULL);
+    PlayerInput input;
+    input.left = keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A];
+    input.right = keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D];
+    inputZone.end();
 
-        ft.y += ft.vy * deltaTime;
-        ft.vy += 50.0f * deltaTime;
+    while (replaying ? replaySteps > 0 : accumulator >= SIM_STEP) {
+      accumulator -= SIM_STEP;
 
-        if (currentTime - ft.spawnTime > 1000) {
-          ft.active = false;
-        }
+      if (replaying) {
+        replaySteps--;
+        session.replay.nextStep(&input);
+      } else {
+        input.jump = jumpQueued;
+        jumpQueued = false;
       }
+      if (recording)
+        session.replay.recordStep(input);
 
-      // Update enemies
-      for (auto &enemy : enemies) {
-        if (!enemy.active)
-          continue;
-
-        enemy.x += enemy.vx * deltaTime;
-
-        enemy.rect.x = static_cast<int>(enemy.x);
-        enemy.rect.y = static_cast<int>(enemy.y);
-
-        // Bounce off level edges
-        if (enemy.x < 0 || enemy.x > levelWidthPixels - enemy.rect.w) {
-          enemy.vx = -enemy.vx;
-        }
-
-        // Enemy collision with player
-        // Replace enemy collision code:
-        // Enemy collision with player
-        if (SDL_HasIntersection(&playerRect, &enemy.rect)) {
-          if (velocityY > 0 && oldY + PLAYER_SIZE <= enemy.rect.y + 10) {
-            // Jump on enemy
-            enemy.active = false;
-            velocityY = JUMP_FORCE * 0.5f;
-            score += 200;
-            std::cout << "Enemy defeated! Score: " << score << std::endl;
-
-            FloatingText ft;
-            ft.x = enemy.rect.x + enemy.rect.w / 2.0f;
-            ft.y = enemy.rect.y - 10.0f;
-            ft.vy = -120.0f;
-            ft.value = 200;
-            ft.spawnTime = currentTime;
-            ft.active = true;
-            floatingTexts.push_back(ft);
-          } else if (!playerStatus
-                          .isInvincible) { // Only take damage if not invincible
-            lives--;
-            deathCount++;
-            std::cout << "Hit! Lives remaining: " << lives << std::endl;
-
-            isDying = true;
-            dyingStartTime = currentTime;
-            velocityX = 0.0f;
-            velocityY = 0.0f;
-            deathFallVelocity = 0.0f;
-          }
-        }
+      // world.step(), one phase per zone
+      const float dt = static_cast<float>(SIM_STEP);
+      bool simulate;
+      {
+        PROFILE_ZONE("physics");
+        simulate = world.beginStep(dt) && world.stepPlayer(input, dt);
       }
-
-      // Update items
-      for (auto &item : items) {
-        if (!item.active || item.collected)
-          continue;
-
-        // Item physics (pop out then fall)
-        item.vy += GRAVITY * deltaTime * 0.5f;
-        item.y += item.vy * deltaTime;
-
-        item.rect.x = static_cast<int>(item.x) - 16;
-        item.rect.y = static_cast<int>(item.y);
-
-        // Item collision with player
-        if (SDL_HasIntersection(&playerRect, &item.rect)) {
-          item.collected = true;
-
-          switch (item.type) {
-          case ItemType::SWORD:
-            playerStatus.hasSword = true;
-            playerStatus.swordEndTime = currentTime + 10000; // 10 seconds
-            score += 100;
-            std::cout << "SWORD! Speed boost for 10 seconds!" << std::endl;
-            break;
-
-          case ItemType::POISON_MUSHROOM:
-            playerStatus.isPoisoned = true;
-            playerStatus.poisonEndTime = currentTime + 8000; // 8 seconds
-            std::cout << "POISON! Slowed down for 8 seconds!" << std::endl;
-            break;
-
-          case ItemType::POWER_MUSHROOM:
-            playerStatus.isInvincible = true;
-            playerStatus.invincibleEndTime = currentTime + 12000; // 12 seconds
-            score += 200;
-            std::cout << "POWER! Invincible for 12 seconds!" << std::endl;
-            break;
-
-          case ItemType::EXTRA_LIFE:
-            lives++;
-            score += 500;
-            std::cout << "EXTRA LIFE! Lives: " << lives << std::endl;
-            break;
-          }
-
-          // Create floating text
-          FloatingText ft;
-          ft.x = item.x;
-          ft.y = item.y - 10.0f;
-          ft.vy = -80.0f;
-          ft.value = 0; // We'll show text instead
-          ft.spawnTime = currentTime;
-          ft.active = true;
-          floatingTexts.push_back(ft);
+      if (simulate) {
+        {
+          PROFILE_ZONE("collision");
+          world.stepCollision();
         }
-
-        // Remove items that fall off screen
-        if (item.y > windowHeight + 100) {
-          item.active = false;
+        {
+          PROFILE_ZONE("enemies");
+          world.stepEnemies(dt);
         }
+        PROFILE_ZONE("entities");
+        world.stepEntities(dt);
       }
+    }
 
-      // Update power-up timers
-      if (playerStatus.hasSword && currentTime >= playerStatus.swordEndTime) {
-        playerStatus.hasSword = false;
-        std::cout << "Sword effect ended" << std::endl;
-      }
-      if (playerStatus.isPoisoned &&
-          currentTime >= playerStatus.poisonEndTime) {
-        playerStatus.isPoisoned = false;
-        std::cout << "Poison effect ended" << std::endl;
-      }
-      if (playerStatus.isInvincible &&
-          currentTime >= playerStatus.invincibleEndTime) {
-        playerStatus.isInvincible = false;
-        std::cout << "Invincibility ended" << std::endl;
-      }
-
-      // Fall death
-      if (playerY > windowHeight + 50 && !isDying) {
-        lives--;
-        deathCount++;
-        std::cout << "Fell! Lives remaining: " << lives << std::endl;
-
-        // Start death animation
-        isDying = true;
-        dyingStartTime = currentTime;
-        velocityX = 0.0f;
-        velocityY = 0.0f;
-        deathFallVelocity = 0.0f;
-      }
-
-      // Update animation
-      if (velocityX != 0 && isOnGround) {
-        animPhase += deltaTime * 10.0f;
-      }
-
-      for (auto &coin : coins) {
-        coin.animPhase += deltaTime * 3.0f;
-      }
-
-      // Render items
-      for (const auto &item : items) {
-        if (!item.active || item.collected)
-          continue;
-        if (item.x < cameraX - 100 || item.x > cameraX + windowWidth + 100)
-          continue;
-
-        int screenX = static_cast<int>(item.x - cameraX);
-        SDL_Rect itemScreenRect = {screenX - 16, item.rect.y, 32, 32};
-
-        switch (item.type) {
-        case ItemType::SWORD: { // ADD BRACE HERE
-          // Draw sword (gray blade, brown handle)
-          SDL_SetRenderDrawColor(renderer, 192, 192, 192, 255);
-          SDL_Rect blade = {itemScreenRect.x + 8, itemScreenRect.y, 16, 24};
-          SDL_RenderFillRect(renderer, &blade);
-          SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255);
-          SDL_Rect handle = {itemScreenRect.x + 10, itemScreenRect.y + 20, 12,
-                             10};
-          SDL_RenderFillRect(renderer, &handle);
-          break;
-        } // ADD BRACE HERE
-
-        case ItemType::POISON_MUSHROOM: { // ADD BRACE HERE
-          // Draw purple mushroom with skull
-          SDL_SetRenderDrawColor(renderer, 128, 0, 128, 255);
-          SDL_Rect poisonCap = {itemScreenRect.x + 4, itemScreenRect.y, 24, 16};
-          SDL_RenderFillRect(renderer, &poisonCap);
-          SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-          SDL_Rect poisonStem = {itemScreenRect.x + 10, itemScreenRect.y + 14,
-                                 12, 18};
-          SDL_RenderFillRect(renderer, &poisonStem);
-          // Skull dots
-          SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-          SDL_Rect eye1 = {itemScreenRect.x + 10, itemScreenRect.y + 6, 4, 4};
-          SDL_Rect eye2 = {itemScreenRect.x + 18, itemScreenRect.y + 6, 4, 4};
-          SDL_RenderFillRect(renderer, &eye1);
-          SDL_RenderFillRect(renderer, &eye2);
-          break;
-        } // ADD BRACE HERE
-
-        case ItemType::POWER_MUSHROOM: { // ADD BRACE HERE
-          // Draw red mushroom with white dots
-          SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-          SDL_Rect powerCap = {itemScreenRect.x + 4, itemScreenRect.y, 24, 16};
-          SDL_RenderFillRect(renderer, &powerCap);
-          SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-          SDL_Rect dot1 = {itemScreenRect.x + 8, itemScreenRect.y + 4, 4, 4};
-          SDL_Rect dot2 = {itemScreenRect.x + 20, itemScreenRect.y + 4, 4, 4};
-          SDL_RenderFillRect(renderer, &dot1);
-          SDL_RenderFillRect(renderer, &dot2);
-          SDL_SetRenderDrawColor(renderer, 240, 200, 150, 255);
-          SDL_Rect powerStem = {itemScreenRect.x + 10, itemScreenRect.y + 14,
-                                12, 18};
-          SDL_RenderFillRect(renderer, &powerStem);
-          break;
-        } // ADD BRACE HERE
-
-        case ItemType::EXTRA_LIFE: { // ADD BRACE HERE
-          // Draw green heart
-          SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-          SDL_Rect heart = {itemScreenRect.x + 6, itemScreenRect.y + 6, 20, 20};
-          SDL_RenderFillRect(renderer, &heart);
-          SDL_SetRenderDrawColor(renderer, 0, 200, 0, 255);
-          SDL_Rect heartInner = {itemScreenRect.x + 10, itemScreenRect.y + 10,
-                                 12, 12};
-          SDL_RenderFillRect(renderer, &heartInner);
-          break;
-        } // ADD BRACE HERE
-        }
-
-        // Item border
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDrawRect(renderer, &itemScreenRect);
-      }
+    {
+      PROFILE_ZONE("streaming");
+      world.updateStreaming();
     }
 
-  skip_normal_physics:
+    // Blend the last two simulation steps for drawing
+    const float interp = static_cast<float>(accumulator / SIM_STEP);
+    Uint32 currentTime = world.currentTime;
+    float viewX =
+        world.prevCameraX + (world.cameraX - world.prevCameraX) * interp;
+    // Tiles and sprites are placed against one whole-pixel origin, so
+    // they move together while the camera is between pixels
+    const int originX = static_cast<int>(std::floor(viewX));
+    auto toScreenX = [originX](float worldX) {
+      return static_cast<int>(std::floor(worldX)) - originX;
+    };
+    float drawPlayerX =
+        world.prevPlayerX + (world.playerX - world.prevPlayerX) * interp;
+    float drawPlayerY =
+        world.prevPlayerY + (world.playerY - world.prevPlayerY) * interp;
 
     // ======================================
     // ========== RENDERING =================
     // ======================================
 
-    // Calculate sky color based on time of day
-    int skyR, skyG, skyB;
-
-    // dayTime: 0.0 = midnight, 0.25 = sunrise (6am), 0.5 = noon, 0.75 = sunset
-    // (6pm), 1.0 = midnight
-    if (dayTime < 0.25f) {
-      // Night to sunrise (midnight to 6am)
-      float t = dayTime / 0.25f;
-      skyR = static_cast<int>(25 + (255 - 25) * t);
-      skyG = static_cast<int>(25 + (140 - 25) * t);
-      skyB = static_cast<int>(112 + (252 - 112) * t);
-    } else if (dayTime < 0.5f) {
-      // Sunrise to noon (6am to 12pm)
-      float t = (dayTime - 0.25f) / 0.25f;
-      skyR = static_cast<int>(255 - (255 - 92) * t);
-      skyG = static_cast<int>(140 + (148 - 140) * t);
-      skyB = 252;
-    } else if (dayTime < 0.75f) {
-      // Noon to sunset (12pm to 6pm)
-      float t = (dayTime - 0.5f) / 0.25f;
-      skyR = static_cast<int>(92 + (255 - 92) * t);
-      skyG = static_cast<int>(148 - (148 - 100) * t);
-      skyB = static_cast<int>(252 - (252 - 150) * t);
-    } else {
-      // Sunset to night (6pm to midnight)
-      float t = (dayTime - 0.75f) / 0.25f;
-      skyR = static_cast<int>(255 - (255 - 25) * t);
-      skyG = static_cast<int>(100 - (100 - 25) * t);
-      skyB = static_cast<int>(150 - (150 - 112) * t);
-    }
-
-    // Sky background
-    SDL_SetRenderDrawColor(renderer, skyR, skyG, skyB, 255);
-    SDL_RenderClear(renderer);
-
-    // Calculate sun/moon position (moves in an arc across the sky)
-    float celestialAngle = dayTime * 2.0f * 3.14159f; // Full circle
-    int celestialX = windowWidth / 2 +
-                     static_cast<int>(cos(celestialAngle - 3.14159f / 2.0f) *
-                                      windowWidth * 0.4f);
-    int celestialY =
-        100 + static_cast<int>(sin(celestialAngle - 3.14159f / 2.0f) * 150);
-
-    // Draw sun during day (0.2 to 0.8)
-    if (dayTime > 0.2f && dayTime < 0.8f) {
-      // Sun glow
-      SDL_SetRenderDrawColor(renderer, 255, 255, 150, 100);
-      for (int i = 0; i < 3; i++) {
-        SDL_Rect glow = {celestialX - 40 - i * 8, celestialY - 40 - i * 8,
-                         80 + i * 16, 80 + i * 16};
-        SDL_RenderFillRect(renderer, &glow);
-      }
-
-      // Sun body
-      SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-      SDL_Rect sun = {celestialX - 25, celestialY - 25, 50, 50};
-      SDL_RenderFillRect(renderer, &sun);
-
-      // Sun inner circle
-      SDL_SetRenderDrawColor(renderer, 255, 255, 150, 255);
-      SDL_Rect sunInner = {celestialX - 15, celestialY - 15, 30, 30};
-      SDL_RenderFillRect(renderer, &sunInner);
-
-      // Sun rays
-      SDL_SetRenderDrawColor(renderer, 255, 255, 100, 255);
-      for (int i = 0; i < 8; i++) {
-        float angle = i * 3.14159f / 4.0f;
-        int rayX = celestialX + static_cast<int>(cos(angle) * 35);
-        int rayY = celestialY + static_cast<int>(sin(angle) * 35);
-        int rayEndX = celestialX + static_cast<int>(cos(angle) * 50);
-        int rayEndY = celestialY + static_cast<int>(sin(angle) * 50);
-        SDL_RenderDrawLine(renderer, rayX, rayY, rayEndX, rayEndY);
-        SDL_RenderDrawLine(renderer, rayX + 1, rayY, rayEndX + 1, rayEndY);
-        SDL_RenderDrawLine(renderer, rayX, rayY + 1, rayEndX, rayEndY + 1);
-      }
-    }
-
-    // Draw moon during night (0.0 to 0.2 and 0.8 to 1.0)
-    if (dayTime < 0.2f || dayTime > 0.8f) {
-      // Moon glow
-      SDL_SetRenderDrawColor(renderer, 200, 200, 255, 80);
-      SDL_Rect moonGlow = {celestialX - 35, celestialY - 35, 70, 70};
-      SDL_RenderFillRect(renderer, &moonGlow);
-
-      // Moon body
-      SDL_SetRenderDrawColor(renderer, 220, 220, 240, 255);
-      SDL_Rect moon = {celestialX - 20, celestialY - 20, 40, 40};
-      SDL_RenderFillRect(renderer, &moon);
-
-      // Moon craters
-      SDL_SetRenderDrawColor(renderer, 180, 180, 200, 255);
-      SDL_Rect crater1 = {celestialX - 8, celestialY - 10, 8, 8};
-      SDL_Rect crater2 = {celestialX + 5, celestialY - 5, 6, 6};
-      SDL_Rect crater3 = {celestialX - 5, celestialY + 5, 7, 7};
-      SDL_RenderFillRect(renderer, &crater1);
-      SDL_RenderFillRect(renderer, &crater2);
-      SDL_RenderFillRect(renderer, &crater3);
-    }
+    ProfileZone skyZone("sky");
 
-    // Stars during night (more visible at night)
-    if (dayTime < 0.3f || dayTime > 0.7f) {
-      float starAlpha = 1.0f;
-      if (dayTime < 0.3f) {
-        starAlpha = (0.3f - dayTime) / 0.3f;
-      } else {
-        starAlpha = (dayTime - 0.7f) / 0.3f;
-      }
+    // Sky gradient (cached texture), then the star field, sun or moon and
+    // the twinkling stars
+    float night = SkyLayer::starAlpha(world.dayTime);
+    skyLayer.drawSky(renderer, world.dayTime, windowWidth, windowHeight);
+    parallax.draw(renderer, ParallaxKind::STARS, viewX, 255,
+                  static_cast<Uint8>(255 * night));
+    skyLayer.drawCelestial(batch, world.dayTime, currentTime, windowWidth);
 
-      SDL_SetRenderDrawColor(renderer, 255, 255, 255,
-                             static_cast<int>(255 * starAlpha));
-      for (int i = 0; i < 50; i++) {
-        int starX = (i * 137 + 50) % windowWidth;
-        int starY = (i * 239 + 30) % 300;
-        int starSize = 1 + (i % 3);
-
-        // Twinkling effect
-        float twinkle = (sin((currentTime / 1000.0f + i) * 2.0f) + 1.0f) / 2.0f;
-        if (twinkle > 0.5f) {
-          SDL_Rect star = {starX, starY, starSize, starSize};
-          SDL_RenderFillRect(renderer, &star);
-        }
-      }
-    }
-
-    // Clouds with parallax
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    for (int i = 0; i < 5; i++) {
-      int cx = static_cast<int>(200 + i * 350 - cameraX * 0.3f);
-      int cy = 80 + i * 30;
-      if (cx > -100 && cx < windowWidth + 100) {
-        SDL_Rect cloud = {cx, cy, 60, 30};
-        SDL_RenderFillRect(renderer, &cloud);
-      }
-    }
+    // Background layers, each scrolling at its own rate; dimmed at night
+    batch.flush();
+    Uint8 daylight = static_cast<Uint8>(255 - 145 * night);
+    parallax.draw(renderer, ParallaxKind::FAR_CLOUDS, viewX, daylight);
+    parallax.draw(renderer, ParallaxKind::HILLS, viewX, daylight);
+    parallax.draw(renderer, ParallaxKind::NEAR_CLOUDS, viewX, daylight);
 
     // ===== PLATFORMS =====
     int groundY = windowHeight - 80;
 
-    for (const auto &platform : platforms) {
-      // Cull objects outside camera view
-      if (platform.rect.x + platform.rect.w < cameraX - 100)
-        continue;
-      if (platform.rect.x > cameraX + windowWidth + 100)
-        continue;
-
-      SDL_Rect screenRect = {static_cast<int>(platform.rect.x - cameraX),
-                             platform.rect.y, platform.rect.w, platform.rect.h};
-
-      if (platform.isBreakable) {
-        // Question block with more texture
-        if (platform.isHit) {
-          // Used block - darker with texture
-          SDL_SetRenderDrawColor(renderer, 140, 110, 70, 255);
-          SDL_RenderFillRect(renderer, &screenRect);
-
-          // Add texture lines
-          SDL_SetRenderDrawColor(renderer, 100, 80, 50, 255);
-          for (int i = 0; i < 4; i++) {
-            SDL_Rect line = {screenRect.x + i * 8, screenRect.y, 4,
-                             screenRect.h};
-            SDL_RenderFillRect(renderer, &line);
-          }
-
-          SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-          SDL_RenderDrawRect(renderer, &screenRect);
-        } else {
-          // Active question block - animated and textured
-          float bounce = std::sin(currentTime * 0.005f) * 2;
-          SDL_Rect animRect = {screenRect.x,
-                               screenRect.y + static_cast<int>(bounce),
-                               screenRect.w, screenRect.h};
-
-          // Gradient effect - light to dark orange
-          SDL_SetRenderDrawColor(renderer, 255, 200, 100, 255);
-          SDL_RenderFillRect(renderer, &animRect);
-
-          // Top highlight
-          SDL_SetRenderDrawColor(renderer, 255, 230, 150, 255);
-          SDL_Rect highlight = {animRect.x + 2, animRect.y + 2, animRect.w - 4,
-                                8};
-          SDL_RenderFillRect(renderer, &highlight);
-
-          // Bottom shadow
-          SDL_SetRenderDrawColor(renderer, 200, 140, 60, 255);
-          SDL_Rect shadow = {animRect.x + 2, animRect.y + animRect.h - 10,
-                             animRect.w - 4, 8};
-          SDL_RenderFillRect(renderer, &shadow);
-
-          // Border
-          SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-          SDL_RenderDrawRect(renderer, &animRect);
-
-          // Draw "?" with more detail
-          SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-          SDL_Rect qTop = {animRect.x + 10, animRect.y + 6, 12, 8};
-          SDL_RenderFillRect(renderer, &qTop);
-          SDL_Rect qMid = {animRect.x + 14, animRect.y + 12, 8, 6};
-          SDL_RenderFillRect(renderer, &qMid);
-          SDL_Rect qDot = {animRect.x + 14, animRect.y + 20, 6, 6};
-          SDL_RenderFillRect(renderer, &qDot);
+    skyZone.end();
+    ProfileZone tileZone("tiles");
+
+    // Chunk contents are sorted by x, so culling to the view is a binary
+    // search per chunk; what lies outside is never visited
+    const float cullLeft = viewX - 100;
+    const float cullRight = viewX + windowWidth + 100;
+
+    // Level strips cached as textures; tile by tile only without render
+    // targets
+    if (!tileStrips.draw(renderer, tileTextures, world.streamer, originX,
+                         windowWidth, windowHeight, currentTime)) {
+      int bounce = TileStrips::questionBounce(currentTime);
+      for (auto &chunk : world.streamer.getResidentChunks()) {
+        size_t first, last;
+        platformRange(chunk, static_cast<int>(cullLeft) - TILE_SIZE,
+                      static_cast<int>(cullRight), first, last);
+        for (size_t p = first; p < last; p++) {
+          const Platform &platform = chunk.platforms[p];
+          if (!platform.isBreakable && !platform.isBrick)
+            continue;
+
+          TileKind kind = TileStrips::kindOf(platform, groundY);
+          SDL_Rect screenRect = {platform.rect.x - originX,
+                                 platform.rect.y, platform.rect.w,
+                                 platform.rect.h};
+          // Active question blocks bounce
+          if (kind == TileKind::QUESTION)
+            screenRect.y += bounce;
+          tileTextures.draw(renderer, kind, screenRect);
         }
-      } else if (platform.isBrick) {
-        // Ground or brick platform with detailed texture
-        if (platform.rect.y >= groundY - 5) {
-          // Ground with grass texture
-          // Grass layer with detail
-          SDL_SetRenderDrawColor(renderer, 123, 192, 67, 255);
-          SDL_Rect grass = {screenRect.x, screenRect.y, screenRect.w, 20};
-          SDL_RenderFillRect(renderer, &grass);
-
-          // Grass blades
-          SDL_SetRenderDrawColor(renderer, 100, 170, 50, 255);
-          for (int i = 0; i < screenRect.w; i += 4) {
-            SDL_Rect blade = {screenRect.x + i, screenRect.y, 2, 12 + (i % 8)};
-            SDL_RenderFillRect(renderer, &blade);
-          }
+      }
+    }
 
-          // Dirt layer with texture
-          SDL_SetRenderDrawColor(renderer, 139, 90, 43, 255);
-          SDL_Rect dirt = {screenRect.x, screenRect.y + 20, screenRect.w,
-                           screenRect.h - 20};
-          SDL_RenderFillRect(renderer, &dirt);
-
-          // Add dirt texture - random dots and patterns
-          SDL_SetRenderDrawColor(renderer, 120, 75, 35, 255);
-          for (int y = 0; y < screenRect.h - 20; y += 6) {
-            for (int x = 0; x < screenRect.w; x += 8) {
-              int dotSize = ((screenRect.x + x + y) % 3) + 1;
-              SDL_Rect dot = {screenRect.x + x + ((x + y) % 4),
-                              screenRect.y + 20 + y, dotSize, dotSize};
-              SDL_RenderFillRect(renderer, &dot);
-            }
-          }
+    tileZone.end();
+    ProfileZone spriteZone("sprites");
 
-          // Lighter dirt spots
-          SDL_SetRenderDrawColor(renderer, 160, 110, 60, 255);
-          for (int y = 0; y < screenRect.h - 20; y += 8) {
-            for (int x = 0; x < screenRect.w; x += 12) {
-              if ((x + y) % 5 == 0) {
-                SDL_Rect lightSpot = {screenRect.x + x, screenRect.y + 22 + y,
-                                      3, 3};
-                SDL_RenderFillRect(renderer, &lightSpot);
-              }
-            }
-          }
-        } else {
-          // Floating brick platform with detailed texture
-          // Base brick color
-          SDL_SetRenderDrawColor(renderer, 184, 111, 80, 255);
-          SDL_RenderFillRect(renderer, &screenRect);
-
-          // Brick pattern - individual bricks
-          int brickW = 16;
-          int brickH = 16;
-
-          for (int by = 0; by < screenRect.h; by += brickH) {
-            for (int bx = 0; bx < screenRect.w; bx += brickW) {
-              // Offset every other row
-              int offset = (by / brickH) % 2 == 0 ? 0 : brickW / 2;
-              int actualX = screenRect.x + bx + offset;
-
-              // Skip if brick would be completely outside
-              if (actualX >= screenRect.x + screenRect.w ||
-                  actualX + brickW <= screenRect.x)
-                continue;
-
-              // Calculate clipped brick dimensions
-              int brickStartX = actualX;
-              int brickStartY = screenRect.y + by;
-              int brickEndX = actualX + brickW;
-              int brickEndY = screenRect.y + by + brickH;
-
-              // Clip to platform bounds
-              if (brickStartX < screenRect.x)
-                brickStartX = screenRect.x;
-              if (brickEndX > screenRect.x + screenRect.w)
-                brickEndX = screenRect.x + screenRect.w;
-              if (brickEndY > screenRect.y + screenRect.h)
-                brickEndY = screenRect.y + screenRect.h;
-
-              int clippedWidth = brickEndX - brickStartX;
-              int clippedHeight = brickEndY - brickStartY;
-
-              if (clippedWidth > 0 && clippedHeight > 0) {
-                // Brick highlight (top-left)
-                SDL_SetRenderDrawColor(renderer, 210, 140, 100, 255);
-                if (clippedHeight > 2) {
-                  SDL_Rect highlight = {brickStartX, brickStartY,
-                                        clippedWidth - 2, 2};
-                  SDL_RenderFillRect(renderer, &highlight);
-                }
-                if (clippedWidth > 2) {
-                  SDL_Rect highlightL = {brickStartX, brickStartY, 2,
-                                         clippedHeight - 2};
-                  SDL_RenderFillRect(renderer, &highlightL);
-                }
-
-                // Brick shadow (bottom-right)
-                SDL_SetRenderDrawColor(renderer, 140, 80, 60, 255);
-                if (clippedHeight > 2 && clippedWidth > 4) {
-                  SDL_Rect shadow = {brickStartX + 2,
-                                     brickStartY + clippedHeight - 2,
-                                     clippedWidth - 2, 2};
-                  SDL_RenderFillRect(renderer, &shadow);
-                }
-                if (clippedWidth > 2 && clippedHeight > 4) {
-                  SDL_Rect shadowR = {brickStartX + clippedWidth - 2,
-                                      brickStartY + 2, 2, clippedHeight - 2};
-                  SDL_RenderFillRect(renderer, &shadowR);
-                }
-
-                // Mortar lines (dark gray between bricks)
-                SDL_SetRenderDrawColor(renderer, 100, 70, 50, 255);
-                if (brickEndY <= screenRect.y + screenRect.h) {
-                  SDL_Rect mortarH = {brickStartX,
-                                      brickStartY + clippedHeight - 1,
-                                      clippedWidth, 1};
-                  SDL_RenderFillRect(renderer, &mortarH);
-                }
-                if (brickEndX <= screenRect.x + screenRect.w) {
-                  SDL_Rect mortarV = {brickStartX + clippedWidth - 1,
-                                      brickStartY, 1, clippedHeight};
-                  SDL_RenderFillRect(renderer, &mortarV);
-                }
-              }
-            }
-          }
-        }
+    // Sprites are quads from the atlas, submitted together by flush()
+    for (auto &chunk : world.streamer.getResidentChunks()) {
+      const CoinStore &coins = chunk.coins;
+      size_t first, last;
+      sortedRange(coins.x, cullLeft, cullRight, first, last);
+      for (size_t i = first; i < last; i++) {
+        sprites.draw(batch, SpriteId::COIN,
+                     SpriteAtlas::coinFrame(coins.animPhase[i]),
+                     toScreenX(coins.x[i]),
+                     static_cast<int>(coins.y[i]));
       }
     }
 
-    // Coins with better visual
-    for (const auto &coin : coins) {
-      if (!coin.collected) {
-        if (coin.x < cameraX - 100 || coin.x > cameraX + windowWidth + 100)
+    for (auto &chunk : world.streamer.getResidentChunks()) {
+      const EnemyStore &enemies = chunk.enemies;
+      size_t first, last;
+      sortedRange(enemies.x, cullLeft - ENEMY_SIZE, cullRight + ENEMY_SIZE,
+                  first, last);
+      for (size_t e = first; e < last; e++) {
+        float enemyX =
+            enemies.prevX[e] + (enemies.x[e] - enemies.prevX[e]) * interp;
+        if (enemyX < cullLeft || enemyX > cullRight)
           continue;
 
-        float scale = std::abs(std::cos(coin.animPhase));
-        int width = static_cast<int>(16 * scale);
-        if (width < 4)
-          width = 4;
-
-        int screenX = static_cast<int>(coin.x - cameraX);
-
-        // Gold coin with shine effect
-        SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
-        SDL_Rect coinRect = {screenX - width / 2, coin.y - 8, width, 16};
-        SDL_RenderFillRect(renderer, &coinRect);
-
-        // Inner darker gold
-        SDL_SetRenderDrawColor(renderer, 218, 165, 32, 255);
-        SDL_Rect innerCoin = {screenX - width / 2 + 2, coin.y - 6,
-                              width > 4 ? width - 4 : 2, 12};
-        SDL_RenderFillRect(renderer, &innerCoin);
-
-        // Shine highlight
-        if (width > 6) {
-          SDL_SetRenderDrawColor(renderer, 255, 250, 205, 255);
-          SDL_Rect shine = {screenX - width / 2 + 2, coin.y - 6, width / 3, 4};
-          SDL_RenderFillRect(renderer, &shine);
-        }
-
-        // Border
-        SDL_SetRenderDrawColor(renderer, 184, 134, 11, 255);
-        SDL_RenderDrawRect(renderer, &coinRect);
+        float enemyY =
+            enemies.prevY[e] + (enemies.y[e] - enemies.prevY[e]) * interp;
+        sprites.draw(batch, SpriteId::ENEMY,
+                     SpriteAtlas::enemyFrame(enemies.vx[e]),
+                     toScreenX(enemyX),
+                     static_cast<int>(enemyY));
       }
     }
 
-    // Enemies with more detail
-    for (const auto &enemy : enemies) {
-      if (!enemy.active)
-        continue;
-      if (enemy.rect.x < cameraX - 100 ||
-          enemy.rect.x > cameraX + windowWidth + 100)
+    for (const auto &item : world.items) {
+      if (item.x < cullLeft || item.x > cullRight)
         continue;
 
-      SDL_Rect screenRect = {static_cast<int>(enemy.rect.x - cameraX),
-                             enemy.rect.y, enemy.rect.w, enemy.rect.h};
-
-      // Body - brown mushroom/goomba style with texture
-      SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255);
-      SDL_RenderFillRect(renderer, &screenRect);
-
-      // Add texture lines to body
-      SDL_SetRenderDrawColor(renderer, 115, 55, 15, 255);
-      for (int i = 0; i < 3; i++) {
-        SDL_Rect line = {screenRect.x + 4 + i * 7, screenRect.y + 4, 3,
-                         screenRect.h - 8};
-        SDL_RenderFillRect(renderer, &line);
-      }
-
-      // Top cap highlight
-      SDL_SetRenderDrawColor(renderer, 160, 82, 45, 255);
-      SDL_Rect capHighlight = {screenRect.x + 2, screenRect.y + 2,
-                               screenRect.w - 4, 6};
-      SDL_RenderFillRect(renderer, &capHighlight);
-
-      // Eyes with white sclera
-      SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-      SDL_Rect eye1 = {screenRect.x + 5, screenRect.y + 10, 7, 7};
-      SDL_Rect eye2 = {screenRect.x + 16, screenRect.y + 10, 7, 7};
-      SDL_RenderFillRect(renderer, &eye1);
-      SDL_RenderFillRect(renderer, &eye2);
-
-      // Pupils - looking in direction of movement
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-      int pupilOffset = enemy.vx > 0 ? 2 : 0;
-      SDL_Rect pupil1 = {screenRect.x + 7 + pupilOffset, screenRect.y + 12, 3,
-                         4};
-      SDL_Rect pupil2 = {screenRect.x + 18 + pupilOffset, screenRect.y + 12, 3,
-                         4};
-      SDL_RenderFillRect(renderer, &pupil1);
-      SDL_RenderFillRect(renderer, &pupil2);
-
-      // Angry eyebrows
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-      SDL_Rect brow1 = {screenRect.x + 4, screenRect.y + 8, 8, 2};
-      SDL_Rect brow2 = {screenRect.x + 16, screenRect.y + 8, 8, 2};
-      SDL_RenderFillRect(renderer, &brow1);
-      SDL_RenderFillRect(renderer, &brow2);
-
-      // Frown mouth
-      SDL_Rect mouth = {screenRect.x + 10, screenRect.y + 20, 8, 2};
-      SDL_RenderFillRect(renderer, &mouth);
-
-      // Body outline
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-      SDL_RenderDrawRect(renderer, &screenRect);
+      int screenX = toScreenX(item.x);
+      float itemY = item.prevY + (item.y - item.prevY) * interp;
+      sprites.draw(batch, SpriteAtlas::itemSprite(item.type), 0, screenX - 16,
+                   static_cast<int>(itemY));
     }
 
-    // Player with more detail
-    if (!gameOver && !levelComplete) {
-      SDL_Rect playerScreenRect = {static_cast<int>(playerX - cameraX),
-                                   static_cast<int>(playerY), PLAYER_SIZE,
-                                   PLAYER_SIZE};
-
-      // In player rendering, add flashing effect:
+    // Player
+    if (!world.gameOver && !world.levelComplete) {
+      // Flash while dying or invincible
       bool shouldDraw = true;
-      if (isDying) {
-        Uint32 timeSinceDeath = currentTime - dyingStartTime;
+      if (world.isDying) {
+        Uint32 timeSinceDeath = currentTime - world.dyingStartTime;
         if (timeSinceDeath < 500) {
           shouldDraw = (timeSinceDeath / 100) % 2 == 0;
         }
-      } else if (playerStatus.isInvincible) {
-        // Flash effect when invincible
+      } else if (world.playerStatus.isInvincible) {
         shouldDraw = (currentTime / 100) % 2 == 0;
       }
 
       if (shouldDraw) {
-        // Red shirt/body with shading
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_Rect body = {playerScreenRect.x + 4, playerScreenRect.y + 8, 24,
-                         16};
-        SDL_RenderFillRect(renderer, &body);
-
-        // Shirt highlight
-        SDL_SetRenderDrawColor(renderer, 255, 100, 100, 255);
-        SDL_Rect bodyHighlight = {playerScreenRect.x + 6,
-                                  playerScreenRect.y + 10, 20, 4};
-        SDL_RenderFillRect(renderer, &bodyHighlight);
-
-        // Buttons on shirt
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_Rect button1 = {playerScreenRect.x + 14, playerScreenRect.y + 14, 2,
-                            2};
-        SDL_Rect button2 = {playerScreenRect.x + 14, playerScreenRect.y + 19, 2,
-                            2};
-        SDL_RenderFillRect(renderer, &button1);
-        SDL_RenderFillRect(renderer, &button2);
-
-        // Skin tone head with shading
-        SDL_SetRenderDrawColor(renderer, 255, 200, 150, 255);
-        SDL_Rect head = {playerScreenRect.x + 8, playerScreenRect.y, 16, 16};
-        SDL_RenderFillRect(renderer, &head);
-
-        // Face shadow
-        SDL_SetRenderDrawColor(renderer, 230, 180, 130, 255);
-        SDL_Rect faceShadow = {playerScreenRect.x + 8, playerScreenRect.y + 10,
-                               16, 6};
-        SDL_RenderFillRect(renderer, &faceShadow);
-
-        // Eyes
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        int eyeY = playerScreenRect.y + 6;
-        if (isDying)
-          eyeY += 2; // Eyes lower when dying
-        SDL_Rect eye1 = {playerScreenRect.x + 10, eyeY, 3, 3};
-        SDL_Rect eye2 = {playerScreenRect.x + 17, eyeY, 3, 3};
-        SDL_RenderFillRect(renderer, &eye1);
-        SDL_RenderFillRect(renderer, &eye2);
-
-        // Mustache
-        SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
-        SDL_Rect mustache = {playerScreenRect.x + 10, playerScreenRect.y + 10,
-                             12, 3};
-        SDL_RenderFillRect(renderer, &mustache);
-
-        // Red cap with detail
-        SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255);
-        SDL_Rect cap = {playerScreenRect.x + 6, playerScreenRect.y - 4, 20, 8};
-        SDL_RenderFillRect(renderer, &cap);
-
-        // Cap highlight
-        SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
-        SDL_Rect capHighlight = {playerScreenRect.x + 8, playerScreenRect.y - 2,
-                                 16, 3};
-        SDL_RenderFillRect(renderer, &capHighlight);
-
-        // Cap logo "M"
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_Rect mLogo = {playerScreenRect.x + 14, playerScreenRect.y, 4, 4};
-        SDL_RenderFillRect(renderer, &mLogo);
-
-        // Blue overalls/legs with detail
-        SDL_SetRenderDrawColor(renderer, 0, 0, 200, 255);
-        if (isOnGround && !isDying) {
-          int legOffset = static_cast<int>(std::sin(animPhase) * 3);
-          SDL_Rect leg1 = {playerScreenRect.x + 8 + legOffset,
-                           playerScreenRect.y + 24, 6, 8};
-          SDL_Rect leg2 = {playerScreenRect.x + 18 - legOffset,
-                           playerScreenRect.y + 24, 6, 8};
-          SDL_RenderFillRect(renderer, &leg1);
-          SDL_RenderFillRect(renderer, &leg2);
-
-          // Shoe highlights
-          SDL_SetRenderDrawColor(renderer, 100, 50, 0, 255);
-          SDL_Rect shoe1 = {playerScreenRect.x + 7 + legOffset,
-                            playerScreenRect.y + 29, 8, 3};
-          SDL_Rect shoe2 = {playerScreenRect.x + 17 - legOffset,
-                            playerScreenRect.y + 29, 8, 3};
-          SDL_RenderFillRect(renderer, &shoe1);
-          SDL_RenderFillRect(renderer, &shoe2);
-        } else {
-          SDL_Rect leg = {playerScreenRect.x + 10, playerScreenRect.y + 24, 12,
-                          8};
-          SDL_RenderFillRect(renderer, &leg);
-
-          // Shoe
-          SDL_SetRenderDrawColor(renderer, 100, 50, 0, 255);
-          SDL_Rect shoe = {playerScreenRect.x + 9, playerScreenRect.y + 29, 14,
-                           3};
-          SDL_RenderFillRect(renderer, &shoe);
-        }
+        int frame = SpriteAtlas::playerFrame(world.isOnGround, world.isDying,
+                                             world.animPhase);
+        sprites.draw(batch, SpriteId::PLAYER, frame,
+                     toScreenX(drawPlayerX),
+                     static_cast<int>(drawPlayerY));
       }
     }
+    sprites.flush(batch);
 
     // Floating texts
     if (smallFont) {
-      for (const auto &ft : floatingTexts) {
-        if (!ft.active)
-          continue;
-        if (ft.x < cameraX - 100 || ft.x > cameraX + windowWidth + 100)
+      for (const auto &ft : world.floatingTexts) {
+        if (ft.x < viewX - 100 || ft.x > viewX + windowWidth + 100)
           continue;
 
+        float ftY = ft.prevY + (ft.y - ft.prevY) * interp;
         Uint32 age = currentTime - ft.spawnTime;
         int alpha = 255 - (age * 255 / 1000);
         if (alpha < 0)
@@ -1393,85 +365,88 @@ bool runGameBox(SDL_Renderer *renderer) {
         char scoreStr[16];
         snprintf(scoreStr, sizeof(scoreStr), "+%d", ft.value);
 
-        int screenX = static_cast<int>(ft.x - cameraX);
+        int screenX = toScreenX(ft.x);
         SDL_Color color = {255, 255, 0, static_cast<Uint8>(alpha)};
-        renderText(renderer, smallFont, scoreStr, screenX,
-                   static_cast<int>(ft.y), color, true);
+        renderText(batch, smallFont, scoreStr, screenX,
+                   static_cast<int>(ftY), color, true);
       }
     }
 
+    spriteZone.end();
+    ProfileZone hudZone("hud");
+
     // ===== UI =====
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    batch.setColor(0, 0, 0, 200);
     SDL_Rect scoreBox = {10, 10, 260, 40};
-    SDL_RenderFillRect(renderer, &scoreBox);
+    batch.fillRect(scoreBox);
 
-    SDL_SetRenderDrawColor(renderer, 255, 220, 0, 255);
-    SDL_RenderDrawRect(renderer, &scoreBox);
+    batch.setColor(255, 220, 0, 255);
+    batch.drawRect(scoreBox);
 
     if (gameFont) {
       char scoreText[32];
-      snprintf(scoreText, sizeof(scoreText), "SCORE: %d", score);
+      snprintf(scoreText, sizeof(scoreText), "SCORE: %d", world.score);
       SDL_Color yellow = {255, 220, 0, 255};
-      renderText(renderer, gameFont, scoreText, 18, 28, yellow, false);
+      renderText(batch, gameFont, scoreText, 18, 28, yellow, false);
     }
 
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    batch.setColor(0, 0, 0, 200);
     SDL_Rect livesBox = {285, 10, 250, 40};
-    SDL_RenderFillRect(renderer, &livesBox);
+    batch.fillRect(livesBox);
 
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_RenderDrawRect(renderer, &livesBox);
+    batch.setColor(255, 0, 0, 255);
+    batch.drawRect(livesBox);
 
     if (gameFont) {
       SDL_Color white = {255, 255, 255, 255};
-      renderText(renderer, gameFont, "LIVES:", 295, 28, white, false);
+      renderText(batch, gameFont, "LIVES:", 295, 28, white, false);
     }
 
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    for (int i = 0; i < lives; i++) {
+    batch.setColor(255, 0, 0, 255);
+    for (int i = 0; i < world.lives; i++) {
       SDL_Rect heart = {415 + i * 32, 19, 18, 18};
-      SDL_RenderFillRect(renderer, &heart);
+      batch.fillRect(heart);
     }
 
     // Show active power-ups
     int statusY = 60;
-    if (playerStatus.hasSword) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    if (world.playerStatus.hasSword) {
+      batch.setColor(0, 0, 0, 200);
       SDL_Rect swordBox = {10, statusY, 180, 30};
-      SDL_RenderFillRect(renderer, &swordBox);
-      SDL_SetRenderDrawColor(renderer, 192, 192, 192, 255);
-      SDL_RenderDrawRect(renderer, &swordBox);
+      batch.fillRect(swordBox);
+      batch.setColor(192, 192, 192, 255);
+      batch.drawRect(swordBox);
       if (smallFont) {
         SDL_Color white = {255, 255, 255, 255};
-        renderText(renderer, smallFont, "SPEED BOOST", 18, statusY + 15, white,
+        renderText(batch, smallFont, "SPEED BOOST", 18, statusY + 15, white,
                    false);
       }
       statusY += 35;
     }
 
-    if (playerStatus.isPoisoned) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    if (world.playerStatus.isPoisoned) {
+      batch.setColor(0, 0, 0, 200);
       SDL_Rect poisonBox = {10, statusY, 180, 30};
-      SDL_RenderFillRect(renderer, &poisonBox);
-      SDL_SetRenderDrawColor(renderer, 128, 0, 128, 255);
-      SDL_RenderDrawRect(renderer, &poisonBox);
+      batch.fillRect(poisonBox);
+      batch.setColor(128, 0, 128, 255);
+      batch.drawRect(poisonBox);
       if (smallFont) {
         SDL_Color purple = {200, 100, 200, 255};
-        renderText(renderer, smallFont, "POISONED", 18, statusY + 15, purple,
+        renderText(batch, smallFont, "POISONED", 18, statusY + 15, purple,
                    false);
       }
       statusY += 35;
     }
 
-    if (playerStatus.isInvincible) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    if (world.playerStatus.isInvincible) {
+      batch.setColor(0, 0, 0, 200);
       SDL_Rect invBox = {10, statusY, 180, 30};
-      SDL_RenderFillRect(renderer, &invBox);
-      SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
-      SDL_RenderDrawRect(renderer, &invBox);
+      batch.fillRect(invBox);
+      batch.setColor(255, 215, 0, 255);
+      batch.drawRect(invBox);
       if (smallFont) {
         SDL_Color gold = {255, 215, 0, 255};
-        renderText(renderer, smallFont, "INVINCIBLE", 18, statusY + 15, gold,
+        renderText(batch, smallFont, "INVINCIBLE", 18, statusY + 15, gold,
                    false);
       }
 
@@ -1481,29 +456,29 @@ bool runGameBox(SDL_Renderer *renderer) {
     }
 
     // Death Screen (Cat Mario style)
-    if (isDying) {
-      Uint32 timeSinceDeath = currentTime - dyingStartTime;
+    if (world.isDying) {
+      Uint32 timeSinceDeath = currentTime - world.dyingStartTime;
 
       // Show black screen with death count during phase 3 (2000-4000ms)
       if (timeSinceDeath >= 2000 && timeSinceDeath < 4000) {
         // Black screen overlay
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        batch.setColor(0, 0, 0, 255);
         SDL_Rect blackScreen = {0, 0, windowWidth, windowHeight};
-        SDL_RenderFillRect(renderer, &blackScreen);
+        batch.fillRect(blackScreen);
 
         // Draw UI box
-        SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
+        batch.setColor(139, 0, 0, 255);
         SDL_Rect deathBox = {windowWidth / 2 - 300, windowHeight / 2 - 120, 600,
                              240};
-        SDL_RenderFillRect(renderer, &deathBox);
+        batch.fillRect(deathBox);
 
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderDrawRect(renderer, &deathBox);
+        batch.setColor(255, 255, 255, 255);
+        batch.drawRect(deathBox);
 
         // Draw inner border
         SDL_Rect innerBorder = {windowWidth / 2 - 290, windowHeight / 2 - 110,
                                 580, 220};
-        SDL_RenderDrawRect(renderer, &innerBorder);
+        batch.drawRect(innerBorder);
 
         if (gameFont) {
           SDL_Color red = {255, 0, 0, 255};
@@ -1513,131 +488,158 @@ bool runGameBox(SDL_Renderer *renderer) {
           const char *deathMessages[] = {"YOU DIED!",  "OUCH!",
                                          "TRY AGAIN!", "GAME OVER... NOT!",
                                          "SO CLOSE!",  "KEEP TRYING!"};
-          int msgIndex = deathCount % 6;
+          int msgIndex = world.deathCount % 6;
           snprintf(deathMsg, sizeof(deathMsg), "%s", deathMessages[msgIndex]);
-          renderText(renderer, gameFont, deathMsg, windowWidth / 2,
+          renderText(batch, gameFont, deathMsg, windowWidth / 2,
                      windowHeight / 2 - 60, red, true);
 
           // Show death count
           char deathCountText[64];
           snprintf(deathCountText, sizeof(deathCountText), "Deaths: %d",
-                   deathCount);
+                   world.deathCount);
           SDL_Color white = {255, 255, 255, 255};
-          renderText(renderer, gameFont, deathCountText, windowWidth / 2,
+          renderText(batch, gameFont, deathCountText, windowWidth / 2,
                      windowHeight / 2 - 10, white, true);
 
           // Show current score
           char currentScore[64];
-          snprintf(currentScore, sizeof(currentScore), "Score: %d", score);
-          renderText(renderer, gameFont, currentScore, windowWidth / 2,
+          snprintf(currentScore, sizeof(currentScore), "Score: %d",
+                   world.score);
+          renderText(batch, gameFont, currentScore, windowWidth / 2,
                      windowHeight / 2 + 30, white, true);
         }
 
         if (smallFont) {
           SDL_Color gray = {200, 200, 200, 255};
-          renderText(renderer, smallFont, "Respawning...", windowWidth / 2,
+          renderText(batch, smallFont, "Respawning...", windowWidth / 2,
                      windowHeight / 2 + 80, gray, true);
         }
       }
     }
 
     // Level Complete Screen
-    if (levelComplete) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    if (world.levelComplete) {
+      batch.setColor(0, 0, 0, 200);
       SDL_Rect overlay = {0, 0, windowWidth, windowHeight};
-      SDL_RenderFillRect(renderer, &overlay);
+      batch.fillRect(overlay);
 
-      SDL_SetRenderDrawColor(renderer, 0, 139, 0, 255);
+      batch.setColor(0, 139, 0, 255);
       SDL_Rect completeBox = {windowWidth / 2 - 300, windowHeight / 2 - 150,
                               600, 300};
-      SDL_RenderFillRect(renderer, &completeBox);
+      batch.fillRect(completeBox);
 
-      SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-      SDL_RenderDrawRect(renderer, &completeBox);
+      batch.setColor(255, 255, 255, 255);
+      batch.drawRect(completeBox);
 
       // Draw inner border
       SDL_Rect innerBorder = {windowWidth / 2 - 290, windowHeight / 2 - 140,
                               580, 280};
-      SDL_RenderDrawRect(renderer, &innerBorder);
+      batch.drawRect(innerBorder);
 
       if (gameFont) {
         SDL_Color yellow = {255, 255, 0, 255};
-        renderText(renderer, gameFont, "LEVEL COMPLETE!", windowWidth / 2,
+        renderText(batch, gameFont, "LEVEL COMPLETE!", windowWidth / 2,
                    windowHeight / 2 - 80, yellow, true);
 
         SDL_Color white = {255, 255, 255, 255};
         char finalScore[64];
-        snprintf(finalScore, sizeof(finalScore), "SCORE: %d", score);
-        renderText(renderer, gameFont, finalScore, windowWidth / 2,
+        snprintf(finalScore, sizeof(finalScore), "SCORE: %d", world.score);
+        renderText(batch, gameFont, finalScore, windowWidth / 2,
                    windowHeight / 2 - 20, white, true);
 
         char deaths[64];
-        snprintf(deaths, sizeof(deaths), "Deaths: %d", deathCount);
-        renderText(renderer, gameFont, deaths, windowWidth / 2,
+        snprintf(deaths, sizeof(deaths), "Deaths: %d", world.deathCount);
+        renderText(batch, gameFont, deaths, windowWidth / 2,
                    windowHeight / 2 + 30, white, true);
       }
 
       if (smallFont) {
         SDL_Color gray = {200, 200, 200, 255};
-        renderText(renderer, smallFont, "Press R to restart", windowWidth / 2,
+        renderText(batch, smallFont, "Press R to restart", windowWidth / 2,
                    windowHeight / 2 + 80, gray, true);
-        renderText(renderer, smallFont, "Press ESC to exit", windowWidth / 2,
+        renderText(batch, smallFont, "Press ESC to exit", windowWidth / 2,
                    windowHeight / 2 + 110, gray, true);
       }
     }
 
     // Game Over Screen
-    if (gameOver) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    if (world.gameOver) {
+      batch.setColor(0, 0, 0, 200);
       SDL_Rect overlay = {0, 0, windowWidth, windowHeight};
-      SDL_RenderFillRect(renderer, &overlay);
+      batch.fillRect(overlay);
 
-      SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
+      batch.setColor(139, 0, 0, 255);
       SDL_Rect gameOverBox = {windowWidth / 2 - 300, windowHeight / 2 - 150,
                               600, 300};
-      SDL_RenderFillRect(renderer, &gameOverBox);
+      batch.fillRect(gameOverBox);
 
-      SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-      SDL_RenderDrawRect(renderer, &gameOverBox);
+      batch.setColor(255, 255, 255, 255);
+      batch.drawRect(gameOverBox);
 
       // Draw inner border
       SDL_Rect innerBorder = {windowWidth / 2 - 290, windowHeight / 2 - 140,
                               580, 280};
-      SDL_RenderDrawRect(renderer, &innerBorder);
+      batch.drawRect(innerBorder);
 
       if (gameFont) {
         SDL_Color red = {255, 50, 50, 255};
-        renderText(renderer, gameFont, "GAME OVER", windowWidth / 2,
+        renderText(batch, gameFont, "GAME OVER", windowWidth / 2,
                    windowHeight / 2 - 80, red, true);
 
         SDL_Color white = {255, 255, 255, 255};
         char finalScore[64];
-        snprintf(finalScore, sizeof(finalScore), "FINAL SCORE: %d", score);
-        renderText(renderer, gameFont, finalScore, windowWidth / 2,
+        snprintf(finalScore, sizeof(finalScore), "FINAL SCORE: %d",
+                 world.score);
+        renderText(batch, gameFont, finalScore, windowWidth / 2,
                    windowHeight / 2 - 20, white, true);
 
         char deaths[64];
-        snprintf(deaths, sizeof(deaths), "Total Deaths: %d", deathCount);
-        renderText(renderer, gameFont, deaths, windowWidth / 2,
+        snprintf(deaths, sizeof(deaths), "Total Deaths: %d", world.deathCount);
+        renderText(batch, gameFont, deaths, windowWidth / 2,
                    windowHeight / 2 + 30, white, true);
       }
 
       if (smallFont) {
         SDL_Color gray = {200, 200, 200, 255};
-        renderText(renderer, smallFont, "Press R to restart", windowWidth / 2,
+        renderText(batch, smallFont, "Press R to restart", windowWidth / 2,
                    windowHeight / 2 + 80, gray, true);
-        renderText(renderer, smallFont, "Press ESC to exit", windowWidth / 2,
+        renderText(batch, smallFont, "Press ESC to exit", windowWidth / 2,
                    windowHeight / 2 + 110, gray, true);
       }
     }
 
+    // Render stats overlay (F3)
+    if (showRenderStats && smallFont) {
+      const RenderBatch::Stats &stats = batch.getFrameStats();
+      char statsText[64];
+      snprintf(statsText, sizeof(statsText), "BATCHES: %d  VERTS: %d",
+               stats.batches, stats.vertices);
+      SDL_Color white = {255, 255, 255, 255};
+      renderText(batch, smallFont, statsText, 10, windowHeight - 20, white,
+                 false);
+    }
+
+    // Profiler overlay (F4), F5 writes gamw_trace.json
+    if (profiler.isOverlayVisible()) {
+      profiler.drawOverlay(batch, smallFont, windowWidth - 310, 60);
+    }
+    hudZone.end();
+
+    // Includes the wait for vsync
+    PROFILE_ZONE("present");
+    batch.endFrame();
     SDL_RenderPresent(renderer);
-    SDL_Delay(16);
   }
 
-  if (gameFont)
-    TTF_CloseFont(gameFont);
-  if (smallFont)
-    TTF_CloseFont(smallFont);
   return true;
 }
+
+bool runGameBox(SDL_Renderer *renderer, GameSession &session) {
+  bool playAgain = playSession(renderer, session);
+
+  // A recording or replay covers one run
+  session.endReplay();
+  if (playAgain)
+    session.restart(static_cast<unsigned int>(rand()));
+  return playAgain;
+}
@@ -0,0 +1,101 @@
+#include "GameSession.h"
+#include "Log.h"
+#include "ResourceManager.h"
+#include "TextCache.h"
+
+GameSession::GameSession()
+    : gameFont(nullptr), smallFont(nullptr), replayMode(ReplayMode::OFF),
+      renderTargetsReset(false), viewWidth(0), viewHeight(0) {}
+
+GameSession::~GameSession() {
+  ResourceManager &resources = ResourceManager::instance();
+  resources.releaseFont(gameFont);
+  resources.releaseFont(smallFont);
+}
+
+void GameSession::setReplay(ReplayMode mode, const std::string &path) {
+  replayMode = mode;
+  replayPath = path;
+}
+
+bool GameSession::load(int width, int height, unsigned int seed) {
+  viewWidth = width;
+  viewHeight = height;
+
+  if (replayMode == ReplayMode::PLAY) {
+    if (!replay.load(replayPath))
+      return false;
+    // The world has to see exactly what the recording saw
+    viewWidth = replay.getViewWidth();
+    viewHeight = replay.getViewHeight();
+    seed = replay.getSeed();
+  }
+
+  // Prefer the cooked level; the text version is cooked on the fly
+  if (!level.open("assets/levels/main.lvl") &&
+      !level.open("assets/levels/main.txt")) {
+    LOG_ERROR("No level to play");
+    return false;
+  }
+
+  if (replayMode == ReplayMode::PLAY &&
+      (replay.getLevelColumns() != level.getColumns() ||
+       replay.getLevelRows() != level.getRows())) {
+    LOG_WARN("Replay %s was recorded on a different level",
+             replayPath.c_str());
+  } else if (replayMode == ReplayMode::RECORD) {
+    replay.startRecording(seed, viewWidth, viewHeight, level.getColumns(),
+                          level.getRows());
+  }
+
+  restart(seed);
+  return true;
+}
+
+void GameSession::restart(unsigned int seed) {
+  world.reset(new GameWorld());
+  world->load(level, viewWidth, viewHeight, seed);
+}
+
+void GameSession::endReplay() {
+  if (replayMode == ReplayMode::RECORD) {
+    replay.finishRecording(*world);
+    if (replay.save(replayPath)) {
+      LOG_INFO("Recorded %lu frames to %s",
+               static_cast<unsigned long>(replay.getFrameCount()),
+               replayPath.c_str());
+    }
+  } else if (replayMode == ReplayMode::PLAY) {
+    if (!replay.atEnd()) {
+      LOG_INFO("Replay stopped early");
+    } else if (ReplayResult::capture(*world) == replay.getResult()) {
+      LOG_INFO("Replay matches the recording");
+    } else {
+      LOG_WARN("Replay diverged from the recording");
+    }
+  }
+  replayMode = ReplayMode::OFF;
+}
+
+void GameSession::upload(SDL_Renderer *renderer) {
+  ResourceManager &resources = ResourceManager::instance();
+  if (!gameFont)
+    gameFont = resources.acquireUIFont(20);
+  if (!smallFont)
+    smallFont = resources.acquireUIFont(16);
+
+  // Build the glyph atlases now rather than on the first game frame
+  TextCache &textCache = TextCache::instance();
+  if (gameFont)
+    textCache.measureText(renderer, gameFont, "0", nullptr, nullptr);
+  if (smallFont)
+    textCache.measureText(renderer, smallFont, "0", nullptr, nullptr);
+
+  // Tile art is baked once per level instead of drawn primitive by primitive
+  tileTextures.bake(renderer);
+  sprites.bake(renderer);
+
+  int outputWidth, outputHeight;
+  SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+  parallax.bake(renderer, outputWidth, outputHeight);
+}
@@ -0,0 +1,583 @@
+#include "GameWorld.h"
+#include "Log.h"
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+
+// Union of a box's rectangles before and after a move, the area it can
+// touch on the way. Rounded outwards: a box at y = 608.1 already overlaps
+// a platform at y = 640.
+static SDL_Rect sweptArea(float fromX, float fromY, float toX, float toY,
+                          int size) {
+  SDL_Rect area;
+  area.x = static_cast<int>(std::floor(std::min(fromX, toX)));
+  area.y = static_cast<int>(std::floor(std::min(fromY, toY)));
+  area.w = static_cast<int>(std::ceil(std::max(fromX, toX))) - area.x + size;
+  area.h = static_cast<int>(std::ceil(std::max(fromY, toY))) - area.y + size;
+  return area;
+}
+
+GameWorld::GameWorld()
+    : viewWidth(0), viewHeight(0), levelWidthPixels(0), playerX(100.0f),
+      playerY(100.0f), playerStartX(100.0f), playerStartY(100.0f),
+      velocityX(0.0f), velocityY(0.0f), isOnGround(false), facingRight(true),
+      cameraX(0.0f), prevPlayerX(100.0f), prevPlayerY(100.0f),
+      prevCameraX(0.0f), score(0), lives(3), gameOver(false),
+      levelComplete(false), deathTime(0), isDying(false), dyingStartTime(0),
+      deathFallVelocity(0.0f), deathCount(0), animPhase(0.0f), dayTime(0.0f),
+      simTime(0.0), currentTime(0), items(MAX_ITEMS),
+      floatingTexts(MAX_FLOATING_TEXTS), enemyWakeDistance(256.0f),
+      oldX(0.0f), oldY(0.0f) {
+  playerRect = {0, 0, PLAYER_SIZE, PLAYER_SIZE};
+}
+
+void GameWorld::load(const CookedLevel &level, int width, int height,
+                     unsigned int itemSeed) {
+  viewWidth = width;
+  viewHeight = height;
+
+  streamer.load(level, viewHeight, itemSeed);
+  levelWidthPixels = streamer.getWidthPixels();
+  playerStartX = streamer.getPlayerStartX();
+  playerStartY = streamer.getPlayerStartY();
+  streamer.update(cameraX, viewWidth);
+
+  // Set player to start position
+  playerX = playerStartX;
+  playerY = playerStartY;
+  prevPlayerX = playerX;
+  prevPlayerY = playerY;
+  prevCameraX = cameraX;
+}
+
+void GameWorld::step(const PlayerInput &input, float deltaTime) {
+  if (!beginStep(deltaTime))
+    return;
+  if (!stepPlayer(input, deltaTime))
+    return;
+  stepCollision();
+  stepEnemies(deltaTime);
+  stepEntities(deltaTime);
+}
+
+bool GameWorld::beginStep(float deltaTime) {
+  // Keep the state the renderer interpolates from
+  prevPlayerX = playerX;
+  prevPlayerY = playerY;
+  prevCameraX = cameraX;
+
+  simTime += deltaTime;
+  currentTime = static_cast<Uint32>(simTime * 1000.0);
+
+  if (gameOver || levelComplete)
+    return false;
+
+  dayTime = static_cast<float>(fmod(simTime / DAY_CYCLE_DURATION, 1.0));
+  return true;
+}
+
+bool GameWorld::stepPlayer(const PlayerInput &input, float deltaTime) {
+  // ------- INPUT -------
+  velocityX = 0.0f;
+
+  if (input.jump && isOnGround) {
+    velocityY = JUMP_FORCE;
+    isOnGround = false;
+  }
+
+  // Only allow input if not dying
+  if (!isDying) {
+    if (input.left) {
+      float speed = MOVE_SPEED;
+      if (playerStatus.hasSword)
+        speed *= 1.5f; // 50% faster
+      if (playerStatus.isPoisoned)
+        speed *= 0.5f; // 50% slower
+      velocityX = -speed;
+      facingRight = false;
+    }
+    if (input.right) {
+      float speed = MOVE_SPEED;
+      if (playerStatus.hasSword)
+        speed *= 1.5f;
+      if (playerStatus.isPoisoned)
+        speed *= 0.5f;
+      velocityX = speed;
+      facingRight = true;
+    }
+  }
+
+  // ------- PHYSICS -------
+  // Handle death animation
+  if (isDying) {
+    Uint32 timeSinceDeath = currentTime - dyingStartTime;
+
+    // Phase 1: Freeze for 500ms
+    if (timeSinceDeath < 500) {
+      velocityX = 0.0f;
+      velocityY = 0.0f;
+    }
+    // Phase 2: Fall down (500ms - 2000ms)
+    else if (timeSinceDeath < 2000) {
+      velocityX = 0.0f;
+      deathFallVelocity += GRAVITY * deltaTime * 0.5f;
+      playerY += deathFallVelocity * deltaTime;
+    }
+    // Phase 3: Show death screen (2000ms - 4000ms)
+    else if (timeSinceDeath < 4000) {
+      // Just wait, death screen is shown
+    }
+    // Phase 4: Respawn
+    else {
+      if (lives <= 0) {
+        gameOver = true;
+        deathTime = currentTime;
+        LOG_INFO("Game Over! Final Score: %d", score);
+      } else {
+        // Respawn player
+        isDying = false;
+        playerX = playerStartX;
+        playerY = playerStartY;
+        velocityX = 0.0f;
+        velocityY = 0.0f;
+        deathFallVelocity = 0.0f;
+        cameraX = 0.0f;
+
+        // Teleport, don't interpolate across the level
+        prevPlayerX = playerX;
+        prevPlayerY = playerY;
+        prevCameraX = cameraX;
+
+        // Only the chunks around the death point are resident. Page in
+        // the start now: updateStreaming() only runs after this step, and
+        // gravity below would sink the player into a start tile that isn't
+        // there, which the swept resolve then can't push it out of.
+        streamer.update(cameraX, viewWidth);
+      }
+    }
+
+    // Skip normal physics for the rest of this step when dying
+    if (isDying)
+      return false;
+  }
+
+  velocityY += GRAVITY * deltaTime;
+  if (velocityY > 600.0f)
+    velocityY = 600.0f;
+
+  oldX = playerX;
+  oldY = playerY;
+
+  playerX += velocityX * deltaTime;
+  playerY += velocityY * deltaTime;
+
+  // ===== BATAS KIRI - Player tidak bisa mundur melewati camera =====
+  float minPlayerX = cameraX + 50.0f; // 50px dari tepi kiri layar
+  if (playerX < minPlayerX) {
+    playerX = minPlayerX;
+  }
+
+  // ===== UPDATE CAMERA - Smooth follow player =====
+  float targetCameraX = playerX - CAMERA_OFFSET_X;
+  if (targetCameraX > cameraX) {
+    cameraX = targetCameraX;
+  }
+
+  // Batas kamera tidak melewati level
+  if (cameraX < 0)
+    cameraX = 0;
+  if (cameraX > levelWidthPixels - viewWidth) {
+    cameraX = levelWidthPixels - viewWidth;
+  }
+
+  // Check level complete
+  if (playerX >= levelWidthPixels - 100) {
+    levelComplete = true;
+    LOG_INFO("=== LEVEL COMPLETE! === Final Score: %d", score);
+  }
+
+  playerRect = {static_cast<int>(playerX), static_cast<int>(playerY),
+                PLAYER_SIZE, PLAYER_SIZE};
+  return true;
+
+}
+
+void GameWorld::stepCollision() {
+  // ===== COLLISION WITH PLATFORMS =====
+  isOnGround = false;
+
+  // Only platforms in the cells swept by the player this frame can touch
+  // it
+  nearbyPlatforms.clear();
+  streamer.queryPlatforms(
+      sweptArea(oldX, oldY, playerX, playerY, PLAYER_SIZE), nearbyPlatforms);
+
+  // Trace the step's move from the old position, one axis at a time:
+  // across first, then up or down from wherever that stopped. Sliding
+  // along a floor or a wall just works, and a fast fall can't skip a
+  // platform.
+  AABB box = {oldX, oldY, static_cast<float>(PLAYER_SIZE),
+              static_cast<float>(PLAYER_SIZE)};
+  AxisSweep across =
+      sweepAxis(box, SweepAxis::X, playerX - oldX, nearbyPlatforms);
+  if (across.platform)
+    playerX = across.position;
+
+  box.x = playerX;
+  AxisSweep vertical =
+      sweepAxis(box, SweepAxis::Y, playerY - oldY, nearbyPlatforms);
+  if (vertical.platform)
+    playerY = vertical.position;
+
+  if (vertical.platform && velocityY > 0) {
+    // Landed
+    velocityY = 0;
+    isOnGround = true;
+  } else if (vertical.platform) {
+    // Bumped a platform from below
+    Platform &platform = *vertical.platform;
+    velocityY = 0;
+
+    if (platform.isBreakable && !platform.isHit) {
+      streamer.hitBlock(platform);
+      LOG_DEBUG("Block hit!");
+
+      // Create item instead of score
+      Item newItem;
+      newItem.x = platform.rect.x + platform.rect.w / 2.0f;
+      newItem.y = platform.rect.y - 32;
+      newItem.vy = -200.0f; // Pop up velocity
+      newItem.prevY = newItem.y;
+      newItem.type = platform.containedItem;
+      newItem.spawnTime = currentTime;
+      newItem.rect = {static_cast<int>(newItem.x) - 16,
+                      static_cast<int>(newItem.y), 32, 32};
+      items.add(newItem);
+
+      // Show what item appeared
+      const char *itemNames[] = {"SWORD", "POISON", "POWER", "LIFE"};
+      LOG_DEBUG("Item spawned: %s",
+                itemNames[static_cast<int>(newItem.type)]);
+    }
+  }
+
+  playerRect.x = static_cast<int>(playerX);
+  playerRect.y = static_cast<int>(playerY);
+}
+
+bool GameWorld::solidAt(int x, int y) {
+  SDL_Rect point = {x, y, 1, 1};
+  nearbyPlatforms.clear();
+  streamer.queryPlatforms(point, nearbyPlatforms);
+  for (Platform *platform : nearbyPlatforms) {
+    if (SDL_HasIntersection(&point, &platform->rect))
+      return true;
+  }
+  return false;
+}
+
+void GameWorld::stepEnemies(float deltaTime) {
+  // Only enemies near the view move. The wake range stays inside the
+  // chunks kept resident around the view, so an awake enemy never walks
+  // onto ground that isn't loaded.
+  const float maxWake = static_cast<float>(
+      (LevelStreamer::CHUNK_COLUMNS - 2) * TILE_SIZE);
+  const float wake = std::min(enemyWakeDistance, maxWake);
+  const float awakeLeft = cameraX - wake;
+  const float awakeRight = cameraX + viewWidth + wake;
+  const float maxX = static_cast<float>(levelWidthPixels - ENEMY_SIZE);
+  const float size = static_cast<float>(ENEMY_SIZE);
+
+  for (auto &chunk : streamer.getResidentChunks()) {
+    EnemyStore &enemies = chunk.enemies;
+    defeated.clear();
+
+    for (size_t i = 0; i < enemies.size(); i++) {
+      float x = enemies.x[i];
+      float y = enemies.y[i];
+      enemies.prevX[i] = x;
+      enemies.prevY[i] = y;
+      if (x + size < awakeLeft || x > awakeRight)
+        continue; // Asleep
+
+      float &vx = enemies.vx[i];
+      float &vy = enemies.vy[i];
+      vy += GRAVITY * deltaTime;
+      if (vy > 600.0f)
+        vy = 600.0f;
+
+      float dx = vx * deltaTime;
+      float dy = vy * deltaTime;
+      nearbyPlatforms.clear();
+      streamer.queryPlatforms(sweptArea(x, y, x + dx, y + dy, ENEMY_SIZE),
+                              nearbyPlatforms);
+
+      // Same swept resolve as the player: walls turn it around, the
+      // ground stops its fall
+      AABB box = {x, y, size, size};
+      AxisSweep across = sweepAxis(box, SweepAxis::X, dx, nearbyPlatforms);
+      if (across.platform) {
+        x = across.position;
+        vx = -vx;
+      } else {
+        x += dx;
+      }
+
+      box.x = x;
+      AxisSweep vertical = sweepAxis(box, SweepAxis::Y, dy, nearbyPlatforms);
+      bool grounded = vertical.platform && vy > 0.0f;
+      if (vertical.platform) {
+        y = vertical.position;
+        vy = 0.0f;
+      } else {
+        y += dy;
+      }
+
+      if (x < 0.0f || x > maxX) {
+        // Level edges
+        x = std::max(0.0f, std::min(x, maxX));
+        vx = -vx;
+      } else if (grounded) {
+        // Turn around at ledges instead of walking off them. The probe is
+        // the first pixel of floor just ahead of the leading foot.
+        int probeX = static_cast<int>(vx > 0.0f ? std::floor(x + size)
+                                                : std::floor(x) - 1);
+        if (!solidAt(probeX, static_cast<int>(y + size)))
+          vx = -vx;
+      }
+
+      enemies.x[i] = x;
+      enemies.y[i] = y;
+
+      // Fell into a pit
+      if (y > viewHeight + 100)
+        defeated.push_back(i);
+    }
+
+    for (size_t d = defeated.size(); d-- > 0;) {
+      streamer.defeatEnemy(chunk, defeated[d]);
+    }
+
+    // Back in x order for the broadphase in stepEntities()
+    enemies.sortByX();
+  }
+}
+
+void GameWorld::stepEntities(float deltaTime) {
+  // Coin collection
+  SDL_Rect coinCollect = {playerRect.x + 4, playerRect.y + 4,
+                          playerRect.w - 8, playerRect.h - 8};
+  for (auto &chunk : streamer.getResidentChunks()) {
+    hits.clear();
+    findOverlapsSorted(chunk.coins.x, chunk.coins.y, -COIN_SIZE / 2,
+                       COIN_SIZE, coinCollect, hits);
+
+    // Highest index first, so removing never shifts a coin still in hits
+    for (size_t h = hits.size(); h-- > 0;) {
+      int i = hits[h];
+      score += 50;
+      LOG_DEBUG("Coin collected! Score: %d", score);
+
+      // Create floating text for coin
+      FloatingText ft;
+      ft.x = chunk.coins.x[i];
+      ft.y = chunk.coins.y[i] - 10.0f;
+      ft.prevY = ft.y;
+      ft.vy = -80.0f;
+      ft.value = 50;
+      ft.spawnTime = currentTime;
+      floatingTexts.add(ft);
+
+      streamer.collectCoin(chunk, i);
+    }
+  }
+
+  // Update floating texts
+  for (size_t i = 0; i < floatingTexts.size();) {
+    FloatingText &ft = floatingTexts[i];
+    if (currentTime - ft.spawnTime > 1000) {
+      floatingTexts.remove(i);
+      continue;
+    }
+
+    ft.prevY = ft.y;
+    ft.y += ft.vy * deltaTime;
+    ft.vy += 50.0f * deltaTime;
+    i++;
+  }
+
+  // Enemies moved in stepEnemies(); check them against the player
+  for (auto &chunk : streamer.getResidentChunks()) {
+    EnemyStore &enemies = chunk.enemies;
+
+    // Enemy collision with player
+    hits.clear();
+    findOverlapsSorted(enemies.x, enemies.y, 0, ENEMY_SIZE, playerRect,
+                       hits);
+
+    defeated.clear();
+    for (int i : hits) {
+      int enemyX = static_cast<int>(enemies.x[i]);
+      int enemyY = static_cast<int>(enemies.y[i]);
+
+      if (velocityY > 0 && oldY + PLAYER_SIZE <= enemyY + 10) {
+        // Jump on enemy
+        velocityY = JUMP_FORCE * 0.5f;
+        score += 200;
+        LOG_DEBUG("Enemy defeated! Score: %d", score);
+
+        FloatingText ft;
+        ft.x = enemyX + ENEMY_SIZE / 2.0f;
+        ft.y = enemyY - 10.0f;
+        ft.prevY = ft.y;
+        ft.vy = -120.0f;
+        ft.value = 200;
+        ft.spawnTime = currentTime;
+        floatingTexts.add(ft);
+
+        defeated.push_back(i);
+      } else if (!playerStatus.isInvincible) {
+        // Only take damage if not invincible
+        lives--;
+        deathCount++;
+        LOG_INFO("Hit! Lives remaining: %d", lives);
+
+        isDying = true;
+        dyingStartTime = currentTime;
+        velocityX = 0.0f;
+        velocityY = 0.0f;
+        deathFallVelocity = 0.0f;
+      }
+    }
+
+    // hits is ascending, so remove from the back
+    for (size_t d = defeated.size(); d-- > 0;) {
+      streamer.defeatEnemy(chunk, defeated[d]);
+    }
+  }
+
+  // Items only fall, so one that is not in the x band the player swept
+  // through this step can't be picked up; skip the exact tests for it
+  const float bandLeft = std::min(oldX, playerX);
+  const float bandRight = std::max(oldX, playerX) + PLAYER_SIZE;
+
+  // Update items
+  for (size_t i = 0; i < items.size();) {
+    Item &item = items[i];
+
+    // Item physics (pop out then fall)
+    item.prevY = item.y;
+    item.vy += GRAVITY * deltaTime * 0.5f;
+    item.y += item.vy * deltaTime;
+
+    item.rect.x = static_cast<int>(item.x) - 16;
+    item.rect.y = static_cast<int>(item.y);
+
+    // Item collision with player. Items fall ever faster, so besides the
+    // end positions, trace the item's move relative to the player's: a
+    // pickup the two passed through during the step still counts.
+    AABB itemBox = {item.x - 16.0f, item.prevY, 32.0f, 32.0f};
+    AABB playerStart = {oldX, oldY, static_cast<float>(PLAYER_SIZE),
+                        static_cast<float>(PLAYER_SIZE)};
+    SweepHit pickup;
+    bool inBand = itemBox.x + itemBox.w > bandLeft - 1.0f &&
+                  itemBox.x < bandRight + 1.0f;
+    if (inBand && (SDL_HasIntersection(&playerRect, &item.rect) ||
+                   sweepAABB(itemBox, oldX - playerX,
+                             (item.y - item.prevY) - (playerY - oldY),
+                             playerStart, pickup))) {
+
+      switch (item.type) {
+      case ItemType::SWORD:
+        playerStatus.hasSword = true;
+        playerStatus.swordEndTime = currentTime + 10000; // 10 seconds
+        score += 100;
+        LOG_INFO("SWORD! Speed boost for 10 seconds!");
+        break;
+
+      case ItemType::POISON_MUSHROOM:
+        playerStatus.isPoisoned = true;
+        playerStatus.poisonEndTime = currentTime + 8000; // 8 seconds
+        LOG_INFO("POISON! Slowed down for 8 seconds!");
+        break;
+
+      case ItemType::POWER_MUSHROOM:
+        playerStatus.isInvincible = true;
+        playerStatus.invincibleEndTime = currentTime + 12000; // 12 seconds
+        score += 200;
+        LOG_INFO("POWER! Invincible for 12 seconds!");
+        break;
+
+      case ItemType::EXTRA_LIFE:
+        lives++;
+        score += 500;
+        LOG_INFO("EXTRA LIFE! Lives: %d", lives);
+        break;
+      }
+
+      // Create floating text
+      FloatingText ft;
+      ft.x = item.x;
+      ft.y = item.y - 10.0f;
+      ft.prevY = ft.y;
+      ft.vy = -80.0f;
+      ft.value = 0; // We'll show text instead
+      ft.spawnTime = currentTime;
+      floatingTexts.add(ft);
+
+      items.remove(i);
+      continue;
+    }
+
+    // Remove items that fall off screen
+    if (item.y > viewHeight + 100) {
+      items.remove(i);
+      continue;
+    }
+    i++;
+  }
+
+  // Update power-up timers
+  if (playerStatus.hasSword && currentTime >= playerStatus.swordEndTime) {
+    playerStatus.hasSword = false;
+    LOG_INFO("Sword effect ended");
+  }
+  if (playerStatus.isPoisoned &&
+      currentTime >= playerStatus.poisonEndTime) {
+    playerStatus.isPoisoned = false;
+    LOG_INFO("Poison effect ended");
+  }
+  if (playerStatus.isInvincible &&
+      currentTime >= playerStatus.invincibleEndTime) {
+    playerStatus.isInvincible = false;
+    LOG_INFO("Invincibility ended");
+  }
+
+  // Fall death
+  if (playerY > viewHeight + 50 && !isDying) {
+    lives--;
+    deathCount++;
+    LOG_INFO("Fell! Lives remaining: %d", lives);
+
+    // Start death animation
+    isDying = true;
+    dyingStartTime = currentTime;
+    velocityX = 0.0f;
+    velocityY = 0.0f;
+    deathFallVelocity = 0.0f;
+  }
+
+  // Update animation
+  if (velocityX != 0 && isOnGround) {
+    animPhase += deltaTime * 10.0f;
+  }
+
+  for (auto &chunk : streamer.getResidentChunks()) {
+    advanceCoins(chunk.coins, deltaTime * 3.0f);
+  }
+}
+
+void GameWorld::updateStreaming() {
+  // Page level chunks in and out around the camera
+  streamer.update(cameraX, viewWidth);
+}
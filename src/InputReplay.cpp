@@ -0,0 +1,201 @@
+#include "InputReplay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static const char REPLAY_MAGIC[8] = {'G', 'A', 'M', 'W', 'R', 'P', 'L', '\0'};
+// Bumped whenever the simulation changes, since old replays would diverge
+static const uint32_t REPLAY_VERSION = 4;
+
+struct ReplayHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t seed;
+  int32_t viewWidth, viewHeight;
+  int32_t levelColumns, levelRows;
+  uint32_t frameCount;
+  uint32_t stepCount;
+  ReplayResult result;
+};
+
+static const size_t FRAME_RECORD_SIZE = sizeof(double) + sizeof(uint32_t);
+
+enum InputBits { INPUT_LEFT = 1, INPUT_RIGHT = 2, INPUT_JUMP = 4 };
+
+ReplayResult ReplayResult::capture(const GameWorld &world) {
+  ReplayResult r;
+  r.score = world.score;
+  r.lives = world.lives;
+  r.deathCount = world.deathCount;
+  r.playerX = world.playerX;
+  r.playerY = world.playerY;
+  return r;
+}
+
+bool ReplayResult::operator==(const ReplayResult &other) const {
+  // Bit-exact on purpose: a replay either matches or it doesn't
+  return score == other.score && lives == other.lives &&
+         deathCount == other.deathCount &&
+         memcmp(&playerX, &other.playerX, sizeof(float)) == 0 &&
+         memcmp(&playerY, &other.playerY, sizeof(float)) == 0;
+}
+
+InputReplay::InputReplay()
+    : seed(0), viewWidth(0), viewHeight(0), levelColumns(0), levelRows(0),
+      frameCursor(0), stepCursor(0) {
+  memset(&result, 0, sizeof(result));
+}
+
+uint8_t InputReplay::packInput(const PlayerInput &input) {
+  return static_cast<uint8_t>((input.left ? INPUT_LEFT : 0) |
+                              (input.right ? INPUT_RIGHT : 0) |
+                              (input.jump ? INPUT_JUMP : 0));
+}
+
+PlayerInput InputReplay::unpackInput(uint8_t bits) {
+  PlayerInput input;
+  input.left = (bits & INPUT_LEFT) != 0;
+  input.right = (bits & INPUT_RIGHT) != 0;
+  input.jump = (bits & INPUT_JUMP) != 0;
+  return input;
+}
+
+void InputReplay::startRecording(unsigned int levelSeed, int width,
+                                 int height, int columns, int rows) {
+  seed = levelSeed;
+  viewWidth = width;
+  viewHeight = height;
+  levelColumns = columns;
+  levelRows = rows;
+  frames.clear();
+  steps.clear();
+  memset(&result, 0, sizeof(result));
+  rewind();
+}
+
+void InputReplay::recordFrame(double frameTime) {
+  Frame frame = {frameTime, 0};
+  frames.push_back(frame);
+}
+
+void InputReplay::recordStep(const PlayerInput &input) {
+  if (frames.empty())
+    recordFrame(0.0);
+  frames.back().stepCount++;
+  steps.push_back(packInput(input));
+}
+
+void InputReplay::finishRecording(const GameWorld &world) {
+  result = ReplayResult::capture(world);
+}
+
+bool InputReplay::save(const std::string &path) const {
+  ReplayHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+  header.version = REPLAY_VERSION;
+  header.seed = seed;
+  header.viewWidth = viewWidth;
+  header.viewHeight = viewHeight;
+  header.levelColumns = levelColumns;
+  header.levelRows = levelRows;
+  header.frameCount = static_cast<uint32_t>(frames.size());
+  header.stepCount = static_cast<uint32_t>(steps.size());
+  header.result = result;
+
+  std::vector<char> out(sizeof(header) + frames.size() * FRAME_RECORD_SIZE +
+                        steps.size());
+  char *cursor = out.data();
+  memcpy(cursor, &header, sizeof(header));
+  cursor += sizeof(header);
+  for (size_t i = 0; i < frames.size(); i++) {
+    memcpy(cursor, &frames[i].frameTime, sizeof(double));
+    memcpy(cursor + sizeof(double), &frames[i].stepCount, sizeof(uint32_t));
+    cursor += FRAME_RECORD_SIZE;
+  }
+  if (!steps.empty())
+    memcpy(cursor, steps.data(), steps.size());
+
+  std::ofstream file(path.c_str(), std::ios::binary);
+  file.write(out.data(), static_cast<std::streamsize>(out.size()));
+  if (!file) {
+    std::cout << "Cannot write replay: " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool InputReplay::load(const std::string &path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    std::cout << "Cannot open replay: " << path << std::endl;
+    return false;
+  }
+  std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+  ReplayHeader header;
+  if (data.size() < sizeof(header)) {
+    std::cout << "Replay file too small: " << path << std::endl;
+    return false;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (memcmp(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+      header.version != REPLAY_VERSION) {
+    std::cout << "Not a replay (or wrong version): " << path << std::endl;
+    return false;
+  }
+  size_t expected = sizeof(header) + header.frameCount * FRAME_RECORD_SIZE +
+                    header.stepCount;
+  if (data.size() != expected) {
+    std::cout << "Corrupt replay: " << path << std::endl;
+    return false;
+  }
+
+  seed = header.seed;
+  viewWidth = header.viewWidth;
+  viewHeight = header.viewHeight;
+  levelColumns = header.levelColumns;
+  levelRows = header.levelRows;
+  result = header.result;
+
+  const char *cursor = data.data() + sizeof(header);
+  frames.resize(header.frameCount);
+  size_t totalSteps = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    memcpy(&frames[i].frameTime, cursor, sizeof(double));
+    memcpy(&frames[i].stepCount, cursor + sizeof(double), sizeof(uint32_t));
+    totalSteps += frames[i].stepCount;
+    cursor += FRAME_RECORD_SIZE;
+  }
+  if (totalSteps != header.stepCount) {
+    std::cout << "Corrupt replay: " << path << std::endl;
+    return false;
+  }
+  steps.assign(cursor, cursor + header.stepCount);
+
+  rewind();
+  return true;
+}
+
+void InputReplay::rewind() {
+  frameCursor = 0;
+  stepCursor = 0;
+}
+
+bool InputReplay::nextFrame(double *frameTime, int *stepCount) {
+  if (frameCursor >= frames.size())
+    return false;
+  *frameTime = frames[frameCursor].frameTime;
+  *stepCount = static_cast<int>(frames[frameCursor].stepCount);
+  frameCursor++;
+  return true;
+}
+
+bool InputReplay::nextStep(PlayerInput *input) {
+  if (stepCursor >= steps.size())
+    return false;
+  *input = unpackInput(steps[stepCursor++]);
+  return true;
+}
@@ -0,0 +1,282 @@
+#include "LevelStreamer.h"
+#include <algorithm>
+#include <cmath>
+
+// Stable pseudo-random item for the '?' block at (col, row).
+// Hashing the position instead of calling rand() while parsing keeps a
+// block's item the same every time its chunk is paged in again.
+static ItemType itemForBlock(unsigned int seed, int col, int row) {
+  unsigned int h = seed ^ (static_cast<unsigned int>(col) * 0x9E3779B1u) ^
+                   (static_cast<unsigned int>(row) * 0x85EBCA77u);
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+
+  switch (h % 4) {
+  case 0:
+    return ItemType::SWORD;
+  case 1:
+    return ItemType::POISON_MUSHROOM;
+  case 2:
+    return ItemType::POWER_MUSHROOM;
+  default:
+    return ItemType::EXTRA_LIFE;
+  }
+}
+
+LevelStreamer::LevelStreamer()
+    : levelData(nullptr), levelColumns(0), levelRows(0), groundY(0),
+      chunkCount(0), itemSeed(0), playerStartX(100.0f), playerStartY(100.0f) {
+}
+
+void LevelStreamer::load(const CookedLevel &level, int windowHeight,
+                         unsigned int seed) {
+  unload();
+
+  levelData = &level;
+  itemSeed = seed;
+  groundY = windowHeight - 80;
+
+  // Dimensions and the player start were worked out when cooking
+  levelRows = level.getRows();
+  levelColumns = level.getColumns();
+  if (level.getPlayerColumn() >= 0) {
+    playerStartX = static_cast<float>(level.getPlayerColumn() * TILE_SIZE);
+    playerStartY = static_cast<float>(level.getPlayerRow() * TILE_SIZE);
+  }
+
+  chunkCount = (levelColumns + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS;
+  states.assign(chunkCount, ChunkState());
+}
+
+void LevelStreamer::unload() {
+  resident.clear();
+  states.clear();
+  levelData = nullptr;
+  levelColumns = 0;
+  levelRows = 0;
+  chunkCount = 0;
+}
+
+void LevelStreamer::buildChunk(int index, LevelChunk &chunk) {
+  const CookedLevel &level = *levelData;
+  ChunkState &state = states[index];
+
+  int firstCol = index * CHUNK_COLUMNS;
+  int lastCol = std::min(firstCol + CHUNK_COLUMNS, levelColumns);
+
+  chunk.index = index;
+  chunk.startX = firstCol * TILE_SIZE;
+  chunk.width = (lastCol - firstCol) * TILE_SIZE;
+  chunk.platforms.clear();
+  chunk.coins.clear();
+  chunk.enemies.clear();
+
+  // Tiles of this slice, one column at a time, so platforms come out
+  // sorted by x. The full ground sits under each column.
+  for (int col = firstCol; col < lastCol; col++) {
+    for (int row = 0; row < levelRows; row++) {
+      char tile = level.tileAt(col, row);
+      int x = col * TILE_SIZE;
+      int y = row * TILE_SIZE;
+
+      switch (tile) {
+      case 'G': // Ground / Grass
+      case 'B': // Brick platform
+        // Only '?' blocks hold an item; containedItem is never read here
+        chunk.platforms.push_back({{x, y, TILE_SIZE, TILE_SIZE},
+                                   false,
+                                   true,
+                                   false,
+                                   ItemType::SWORD});
+        break;
+
+      case '?': // Question block
+        chunk.platforms.push_back({{x, y, TILE_SIZE, TILE_SIZE},
+                                   true,
+                                   false,
+                                   false,
+                                   itemForBlock(itemSeed, col, row)});
+        break;
+
+      case ' ': // Empty space
+      default:
+        break;
+      }
+    }
+
+    chunk.platforms.push_back({{col * TILE_SIZE, groundY, TILE_SIZE, 80},
+                               false,
+                               true,
+                               false,
+                               ItemType::SWORD});
+  }
+
+  // Entities come pre-sorted by column, so the slice is one range each
+  size_t coinSpawns = 0;
+  const CookedCoin *coins = level.findCoins(firstCol, lastCol, &coinSpawns);
+  for (size_t i = 0; i < coinSpawns; i++) {
+    if (i < state.coinCollected.size() && state.coinCollected[i])
+      continue;
+
+    chunk.coins.add(
+        static_cast<float>(coins[i].column * TILE_SIZE + TILE_SIZE / 2),
+        static_cast<float>(coins[i].row * TILE_SIZE + TILE_SIZE / 2),
+        static_cast<int>(i));
+  }
+
+  size_t enemySpawns = 0;
+  const CookedEnemy *enemies =
+      level.findEnemies(firstCol, lastCol, &enemySpawns);
+  for (size_t i = 0; i < enemySpawns; i++) {
+    bool gone = i < state.enemyDefeated.size() &&
+                (state.enemyDefeated[i] || state.enemyAway[i]);
+    if (gone)
+      continue;
+
+    chunk.enemies.add(static_cast<float>(enemies[i].column * TILE_SIZE),
+                      static_cast<float>(enemies[i].row * TILE_SIZE),
+                      enemies[i].movesRight ? 50.0f : -50.0f, index,
+                      static_cast<int>(i));
+  }
+
+  // First visit sizes the chunk's state, later visits restore it
+  if (state.coinCollected.empty() && state.blockHit.empty() &&
+      state.enemyDefeated.empty()) {
+    state.blockHit.assign(chunk.platforms.size(), false);
+    state.coinCollected.assign(coinSpawns, false);
+    state.enemyDefeated.assign(enemySpawns, false);
+    state.enemyAway.assign(enemySpawns, false);
+  } else {
+    for (size_t i = 0; i < chunk.platforms.size(); i++) {
+      chunk.platforms[i].isHit = state.blockHit[i];
+    }
+  }
+
+  chunk.grid.build(chunk.platforms, TILE_SIZE, chunk.startX);
+}
+
+void LevelStreamer::pageIn(int index, bool atFront) {
+  if (atFront) {
+    resident.push_front(LevelChunk());
+    buildChunk(index, resident.front());
+  } else {
+    resident.push_back(LevelChunk());
+    buildChunk(index, resident.back());
+  }
+}
+
+LevelChunk *LevelStreamer::findResidentChunk(float worldX, int excludeIndex) {
+  for (auto &chunk : resident) {
+    if (chunk.index == excludeIndex)
+      continue;
+    if (worldX >= chunk.startX && worldX < chunk.startX + chunk.width)
+      return &chunk;
+  }
+  return nullptr;
+}
+
+void LevelStreamer::pageOut(bool atFront) {
+  LevelChunk &chunk = atFront ? resident.front() : resident.back();
+  ChunkState &state = states[chunk.index];
+
+  for (size_t i = 0; i < chunk.platforms.size(); i++) {
+    state.blockHit[i] = chunk.platforms[i].isHit;
+  }
+
+  // Collected coins and defeated enemies were recorded when it happened.
+  // Enemies may have walked into a neighbouring chunk. Hand them over if
+  // that chunk stays resident, otherwise let them respawn later.
+  const EnemyStore &enemies = chunk.enemies;
+  for (size_t i = 0; i < enemies.size(); i++) {
+    ChunkState &origin = states[enemies.spawnChunk[i]];
+    LevelChunk *target = findResidentChunk(enemies.x[i], chunk.index);
+    if (target) {
+      target->enemies.addFrom(enemies, i);
+    }
+    origin.enemyAway[enemies.spawnIndex[i]] =
+        target != nullptr && enemies.spawnChunk[i] != target->index;
+  }
+
+  if (atFront)
+    resident.pop_front();
+  else
+    resident.pop_back();
+}
+
+void LevelStreamer::collectCoin(LevelChunk &chunk, size_t index) {
+  states[chunk.index].coinCollected[chunk.coins.spawnIndex[index]] = true;
+  chunk.coins.remove(index);
+}
+
+void LevelStreamer::defeatEnemy(LevelChunk &chunk, size_t index) {
+  const EnemyStore &enemies = chunk.enemies;
+  ChunkState &origin = states[enemies.spawnChunk[index]];
+  origin.enemyDefeated[enemies.spawnIndex[index]] = true;
+  origin.enemyAway[enemies.spawnIndex[index]] = false;
+  chunk.enemies.remove(index);
+}
+
+void LevelStreamer::hitBlock(Platform &block) {
+  block.isHit = true;
+  states[block.rect.x / (CHUNK_COLUMNS * TILE_SIZE)].revision++;
+}
+
+void LevelStreamer::update(float cameraX, int viewWidth) {
+  if (!levelData || chunkCount == 0)
+    return;
+
+  // Keep one chunk of margin on each side of the view
+  int chunkWidth = CHUNK_COLUMNS * TILE_SIZE;
+  int first = static_cast<int>(std::floor(cameraX / chunkWidth)) - 1;
+  int last =
+      static_cast<int>(std::floor((cameraX + viewWidth) / chunkWidth)) + 1;
+  first = std::max(first, 0);
+  last = std::min(last, chunkCount - 1);
+
+  while (!resident.empty() && resident.front().index < first)
+    pageOut(true);
+  while (!resident.empty() && resident.back().index > last)
+    pageOut(false);
+
+  if (resident.empty()) {
+    for (int i = first; i <= last; i++)
+      pageIn(i, false);
+    return;
+  }
+
+  while (resident.front().index > first)
+    pageIn(resident.front().index - 1, true);
+  while (resident.back().index < last)
+    pageIn(resident.back().index + 1, false);
+}
+
+void LevelStreamer::queryPlatforms(const SDL_Rect &area,
+                                   std::vector<Platform *> &out) {
+  for (auto &chunk : resident) {
+    if (area.x + area.w <= chunk.startX ||
+        area.x >= chunk.startX + chunk.width)
+      continue;
+
+    scratch.clear();
+    chunk.grid.query(area, scratch);
+    for (int index : scratch) {
+      out.push_back(&chunk.platforms[index]);
+    }
+  }
+}
+
+void platformRange(const LevelChunk &chunk, int minX, int maxX, size_t &first,
+                   size_t &last) {
+  const std::vector<Platform> &platforms = chunk.platforms;
+  first = static_cast<size_t>(
+      std::lower_bound(platforms.begin(), platforms.end(), minX,
+                       [](const Platform &p, int x) { return p.rect.x < x; }) -
+      platforms.begin());
+  last = static_cast<size_t>(
+      std::upper_bound(platforms.begin() + first, platforms.end(), maxX,
+                       [](int x, const Platform &p) { return x < p.rect.x; }) -
+      platforms.begin());
+}
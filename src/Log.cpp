@@ -0,0 +1,107 @@
+#include "Log.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+
+static const char *const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+static double secondsSinceStart() {
+  static const std::chrono::steady_clock::time_point origin =
+      std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       origin)
+      .count();
+}
+
+Logger &Logger::instance() {
+  // Leaked so messages logged during static destruction are still safe
+  static Logger *logger = new Logger();
+  return *logger;
+}
+
+Logger::Logger()
+    : writePosition(0), readPosition(0), dropped(0), minLevel(LOG_LEVEL_INFO),
+      running(false) {
+  for (size_t i = 0; i < CAPACITY; i++)
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  secondsSinceStart();
+}
+
+void Logger::write(LogLevel level, const char *format, ...) {
+  // Bounded multi-producer ring: a slot is free for position `pos` when its
+  // sequence equals pos, and holds a message once it is pos + 1
+  size_t pos = writePosition.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &slots[pos & (CAPACITY - 1)];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (lag == 0) {
+      if (writePosition.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed))
+        break;
+    } else if (lag < 0) {
+      // Full: the drain thread hasn't freed this slot yet
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = writePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->level = level;
+  slot->time = secondsSinceStart();
+  va_list args;
+  va_start(args, format);
+  vsnprintf(slot->text, MESSAGE_SIZE, format, args);
+  va_end(args);
+
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+size_t Logger::drain() {
+  size_t written = 0;
+  for (;;) {
+    Slot &slot = slots[readPosition & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+      break;
+
+    fprintf(stdout, "[%7.3f] %-5s %s\n", slot.time,
+            LEVEL_NAMES[slot.level < LOG_LEVEL_OFF ? slot.level : 0],
+            slot.text);
+
+    // Hand the slot back for the next lap around the ring
+    slot.sequence.store(readPosition + CAPACITY, std::memory_order_release);
+    readPosition++;
+    written++;
+  }
+
+  size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+  if (lost > 0)
+    fprintf(stdout, "[%7.3f] WARN  %lu log messages dropped\n",
+            secondsSinceStart(), static_cast<unsigned long>(lost));
+
+  if (written > 0 || lost > 0)
+    fflush(stdout);
+  return written;
+}
+
+void Logger::drainMain() {
+  while (running.load()) {
+    if (drain() == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+void Logger::start() {
+  if (running.exchange(true))
+    return;
+  drainer = std::thread(&Logger::drainMain, this);
+}
+
+void Logger::stop() {
+  if (running.exchange(false) && drainer.joinable())
+    drainer.join();
+  drain();
+}
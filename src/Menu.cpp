@@ -1,13 +1,19 @@
 #include "Menu.h"
-#include <iostream>
+#include "Log.h"
+#include "Profiler.h"
+#include "ResourceManager.h"
+#include "TextCache.h"
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <cstdio>
 
 Menu::Menu() 
     : selectedItem(0), titleFont(nullptr), itemFont(nullptr), smallFont(nullptr),
       pulsePhase(0.0f), fadeIn(0.0f), lastSelectTime(0), lastKeyTime(0),
-      windowWidth(800), windowHeight(600), coinRotation(0.0f) {
+      windowWidth(800), windowHeight(600), coinRotation(0.0f),
+      cloudScroll(0.0f), staticLayer(nullptr), selectedButton(nullptr),
+      staticLayerFailed(false), showRenderStats(false), loading(false) {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 }
 
@@ -19,36 +25,14 @@ bool Menu::init(int wWidth, int wHeight) {
     windowWidth = wWidth;
     windowHeight = wHeight;
     
-    // Try to load fonts with multiple fallback paths
-    const char* font_paths[] = {
-        "assets/PressStart2P-Regular.ttf",
-        "assets/fonts/arial.ttf",
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
-        "/usr/share/fonts/TTF/DejaVuSans-Bold.ttf",
-        "C:\\Windows\\Fonts\\arial.ttf"
-    };
-    
-    // Load title font (large)
-    for (const char* path : font_paths) {
-        titleFont = TTF_OpenFont(path, 48);
-        if (titleFont) break;
-    }
-    
-    // Load item font (medium)
-    for (const char* path : font_paths) {
-        itemFont = TTF_OpenFont(path, 24);
-        if (itemFont) break;
-    }
-    
-    // Load small font
-    for (const char* path : font_paths) {
-        smallFont = TTF_OpenFont(path, 14);
-        if (smallFont) break;
-    }
+    // Re-init (F11) hands back the old fonts first; the manager keeps
+    // them open, so getting them again is just a lookup
+    cleanup();
     
-    if (!titleFont || !itemFont || !smallFont) {
-        std::cerr << "Warning: Some fonts failed to load. Install DejaVu fonts or add PressStart2P font." << std::endl;
-    }
+    ResourceManager& resources = ResourceManager::instance();
+    titleFont = resources.acquireUIFont(48);
+    itemFont = resources.acquireUIFont(24);
+    smallFont = resources.acquireUIFont(14);
     
     // Create menu items centered on screen
     int startY = windowHeight / 2 + 50;
@@ -62,25 +46,18 @@ bool Menu::init(int wWidth, int wHeight) {
     items.push_back(MenuItem("SETTINGS", itemX, startY + spacing, itemWidth, itemHeight));
     items.push_back(MenuItem("QUIT", itemX, startY + spacing * 2, itemWidth, itemHeight));
     
-    initClouds();
     lastSelectTime = SDL_GetTicks();
     
-    std::cout << "Menu initialized with " << items.size() << " items" << std::endl;
+    LOG_INFO("Menu initialized with %d items", static_cast<int>(items.size()));
     return true;
 }
 
-void Menu::initClouds() {
-    clouds.clear();
-    for (int i = 0; i < 6; ++i) {
-        Cloud cloud;
-        cloud.x = static_cast<float>(std::rand() % windowWidth);
-        cloud.y = static_cast<float>(50 + std::rand() % 150);
-        cloud.speed = 15.0f + static_cast<float>(std::rand() % 25);
-        clouds.push_back(cloud);
-    }
-}
-
 void Menu::handleEvent(SDL_Event& e, GameState& state, bool& running) {
+    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3) {
+        showRenderStats = !showRenderStats;
+        return;
+    }
+    
     if (e.type == SDL_KEYDOWN) {
         handleKeyboard(e);
         if (e.key.keysym.sym == SDLK_RETURN || e.key.keysym.sym == SDLK_SPACE) {
@@ -91,6 +68,11 @@ void Menu::handleEvent(SDL_Event& e, GameState& state, bool& running) {
     handleMouse(e, state, running);
 }
 
+void Menu::onRenderTargetsReset() {
+    parallax.release();
+    releaseStaticLayer();
+}
+
 void Menu::handleKeyboard(SDL_Event& e) {
     Uint32 currentTime = SDL_GetTicks();
     if (currentTime - lastKeyTime < KEY_REPEAT_DELAY) return;
@@ -112,7 +94,7 @@ void Menu::handleKeyboard(SDL_Event& e) {
             
         case SDLK_ESCAPE:
             lastKeyTime = currentTime;
-            std::cout << "ESC pressed - exiting" << std::endl;
+            LOG_INFO("ESC pressed - exiting");
             break;
     }
 }
@@ -144,21 +126,22 @@ void Menu::handleMouse(SDL_Event& e, GameState& state, bool& running) {
 }
 
 void Menu::selectItem(GameState& state, bool& running) {
-    std::cout << "Selected: " << items[selectedItem].text << std::endl;
+    LOG_INFO("Selected: %s", items[selectedItem].text.c_str());
     
     switch (selectedItem) {
         case 0:  // START GAME
-            state = PLAYING;
-            std::cout << "[*] Starting game..." << std::endl;
+            // The game loads in the background, see Game::update
+            state = LOADING;
+            LOG_INFO("[*] Starting game...");
             break;
             
         case 1:  // SETTINGS
             state = SETTINGS;
-            std::cout << "[*] Opening settings..." << std::endl;
+            LOG_INFO("[*] Opening settings...");
             break;
             
         case 2:  // QUIT
-            std::cout << "[*] Goodbye!" << std::endl;
+            LOG_INFO("[*] Goodbye!");
             running = false;
             break;
     }
@@ -186,184 +169,191 @@ void Menu::update(float deltaTime) {
         items[i].selectAnim += diff * deltaTime * 10.0f;
     }
     
-    // Animate clouds
-    for (auto& cloud : clouds) {
-        cloud.x += cloud.speed * deltaTime;
-        if (cloud.x > windowWidth + 100) {
-            cloud.x = -100;
-            cloud.y = static_cast<float>(50 + std::rand() % 150);
-        }
-    }
+    // Animate clouds: move the camera left so the layers drift right
+    cloudScroll -= 100.0f * deltaTime;
 }
 
 void Menu::render(SDL_Renderer* renderer) {
-    renderBackground(renderer);
-    renderClouds(renderer);
-    renderGround(renderer);
-    renderDecorations(renderer);
-    renderTitle(renderer);
-    renderItems(renderer);
-    renderFooter(renderer);
+    batch.setRenderer(renderer);
+    
+    // Baked on first use, and again after init() for a new window size
+    if (!parallax.isBaked()) {
+        parallax.bake(renderer, windowWidth, windowHeight);
+    }
+    
+    // Pipes and buttons fade in with everything else, so they are only
+    // frozen into the static layer once they are fully opaque
+    if (fadeIn >= 1.0f && !staticLayer && !staticLayerFailed) {
+        PROFILE_ZONE("menu static bake");
+        staticLayerFailed = !buildStaticLayer(renderer);
+    }
+    
+    { PROFILE_ZONE("menu background"); renderBackground(renderer); }
+    { PROFILE_ZONE("menu clouds"); renderClouds(renderer); }
+    if (staticLayer) {
+        PROFILE_ZONE("menu static");
+        SDL_Rect dst = {0, 0, windowWidth, windowHeight};
+        SDL_RenderCopy(renderer, staticLayer, nullptr, &dst);
+    } else {
+        PROFILE_ZONE("menu ground");
+        renderGround();
+    }
+    { PROFILE_ZONE("menu decorations"); renderDecorations(); }
+    { PROFILE_ZONE("menu title"); renderTitle(renderer); }
+    { PROFILE_ZONE("menu items"); renderItems(renderer); }
+    { PROFILE_ZONE("menu footer"); renderFooter(renderer); }
+    
+    // Profiler overlay (F4)
+    Profiler& profiler = Profiler::instance();
+    if (profiler.isOverlayVisible()) {
+        profiler.drawOverlay(batch, smallFont, windowWidth - 310, 10);
+    }
+    
+    PROFILE_ZONE("menu submit");
+    batch.endFrame();
 }
 
 void Menu::renderBackground(SDL_Renderer* renderer) {
-    // Sky blue gradient matching game
-    for (int y = 0; y < windowHeight - 80; ++y) {
-        float t = static_cast<float>(y) / (windowHeight - 80);
-        Uint8 r = static_cast<Uint8>(92 + (255 - 92) * t * 0.3f);
-        Uint8 g = static_cast<Uint8>(148 + (140 - 148) * t * 0.3f);
-        Uint8 b = 252;
-        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-        SDL_RenderDrawLine(renderer, 0, y, windowWidth, y);
-    }
+    // Noon sky matching the game; the gradient is a cached texture
+    skyLayer.drawSky(renderer, 0.5f, windowWidth, windowHeight - 80);
 }
 
 void Menu::renderClouds(SDL_Renderer* renderer) {
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    
-    for (const auto& cloud : clouds) {
-        int cx = static_cast<int>(cloud.x);
-        int cy = static_cast<int>(cloud.y);
-        
-        // Cloud body (matching game style)
-        SDL_Rect main = {cx, cy + 10, 50, 25};
-        SDL_RenderFillRect(renderer, &main);
-        
-        SDL_Rect left = {cx + 10, cy, 35, 30};
-        SDL_RenderFillRect(renderer, &left);
-        
-        SDL_Rect right = {cx + 30, cy + 5, 40, 28};
-        SDL_RenderFillRect(renderer, &right);
-    }
+    // Same baked layers as the game, minus the night sky
+    parallax.draw(renderer, ParallaxKind::FAR_CLOUDS, cloudScroll);
+    parallax.draw(renderer, ParallaxKind::HILLS, 0.0f);
+    parallax.draw(renderer, ParallaxKind::NEAR_CLOUDS, cloudScroll);
 }
 
-void Menu::renderGround(SDL_Renderer* renderer) {
+void Menu::renderGround() {
     int groundY = windowHeight - 80;
     
     // Grass layer with texture (matching game)
-    SDL_SetRenderDrawColor(renderer, 123, 192, 67, 255);
+    batch.setColor(123, 192, 67, 255);
     SDL_Rect grass = {0, groundY, windowWidth, 20};
-    SDL_RenderFillRect(renderer, &grass);
+    batch.fillRect(grass);
     
     // Grass blades
-    SDL_SetRenderDrawColor(renderer, 100, 170, 50, 255);
+    batch.setColor(100, 170, 50, 255);
     for (int i = 0; i < windowWidth; i += 4) {
         SDL_Rect blade = {i, groundY, 2, 12 + (i % 8)};
-        SDL_RenderFillRect(renderer, &blade);
+        batch.fillRect(blade);
     }
     
     // Dirt layer with texture
-    SDL_SetRenderDrawColor(renderer, 139, 90, 43, 255);
+    batch.setColor(139, 90, 43, 255);
     SDL_Rect dirt = {0, groundY + 20, windowWidth, 60};
-    SDL_RenderFillRect(renderer, &dirt);
+    batch.fillRect(dirt);
     
     // Add dirt texture dots
-    SDL_SetRenderDrawColor(renderer, 120, 75, 35, 255);
+    batch.setColor(120, 75, 35, 255);
     for (int y = 0; y < 60; y += 6) {
         for (int x = 0; x < windowWidth; x += 8) {
             int dotSize = ((x + y) % 3) + 1;
             SDL_Rect dot = {x + ((x + y) % 4), groundY + 20 + y, dotSize, dotSize};
-            SDL_RenderFillRect(renderer, &dot);
+            batch.fillRect(dot);
         }
     }
     
     // Lighter dirt spots
-    SDL_SetRenderDrawColor(renderer, 160, 110, 60, 255);
+    batch.setColor(160, 110, 60, 255);
     for (int y = 0; y < 60; y += 8) {
         for (int x = 0; x < windowWidth; x += 12) {
             if ((x + y) % 5 == 0) {
                 SDL_Rect lightSpot = {x, groundY + 22 + y, 3, 3};
-                SDL_RenderFillRect(renderer, &lightSpot);
+                batch.fillRect(lightSpot);
             }
         }
     }
 }
 
-void Menu::renderDecorations(SDL_Renderer* renderer) {
+void Menu::renderDecorations() {
     // Animated coins on both sides
     float coinBounce = std::sin(coinRotation) * 8.0f;
     
     // Left coin
-    renderCoin(renderer, 150, static_cast<int>(windowHeight / 2 - 50 + coinBounce), coinRotation);
+    renderCoin(150, static_cast<int>(windowHeight / 2 - 50 + coinBounce), coinRotation);
     
     // Right coin
-    renderCoin(renderer, windowWidth - 150, static_cast<int>(windowHeight / 2 - 50 + coinBounce), coinRotation + 1.5f);
+    renderCoin(windowWidth - 150, static_cast<int>(windowHeight / 2 - 50 + coinBounce), coinRotation + 1.5f);
     
     // Question blocks
-    renderQuestionBlock(renderer, 120, windowHeight / 2 + 80);
-    renderQuestionBlock(renderer, windowWidth - 120, windowHeight / 2 + 80);
+    renderQuestionBlock(120, windowHeight / 2 + 80);
+    renderQuestionBlock(windowWidth - 120, windowHeight / 2 + 80);
     
-    // Pipes decoration
-    renderPipe(renderer, 80, windowHeight - 140);
-    renderPipe(renderer, windowWidth - 120, windowHeight - 140);
+    // Pipes decoration (part of the static layer once it exists)
+    if (!staticLayer) {
+        renderPipe(80, windowHeight - 140);
+        renderPipe(windowWidth - 120, windowHeight - 140);
+    }
 }
 
-void Menu::renderQuestionBlock(SDL_Renderer* renderer, int x, int y) {
+void Menu::renderQuestionBlock(int x, int y) {
     int size = 32;
     float bounce = std::sin(pulsePhase * 2.0f) * 3.0f;
     SDL_Rect block = {x, static_cast<int>(y + bounce), size, size};
     
     // Orange/yellow base
-    SDL_SetRenderDrawColor(renderer, 255, 200, 100, static_cast<Uint8>(255 * fadeIn));
-    SDL_RenderFillRect(renderer, &block);
+    batch.setColor(255, 200, 100, static_cast<Uint8>(255 * fadeIn));
+    batch.fillRect(block);
     
     // Top highlight
-    SDL_SetRenderDrawColor(renderer, 255, 230, 150, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(255, 230, 150, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect highlight = {block.x + 2, block.y + 2, block.w - 4, 8};
-    SDL_RenderFillRect(renderer, &highlight);
+    batch.fillRect(highlight);
     
     // Bottom shadow
-    SDL_SetRenderDrawColor(renderer, 200, 140, 60, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(200, 140, 60, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect shadow = {block.x + 2, block.y + block.h - 10, block.w - 4, 8};
-    SDL_RenderFillRect(renderer, &shadow);
+    batch.fillRect(shadow);
     
     // Border
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(255 * fadeIn));
-    SDL_RenderDrawRect(renderer, &block);
+    batch.setColor(0, 0, 0, static_cast<Uint8>(255 * fadeIn));
+    batch.drawRect(block);
     
     // Draw "?"
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(255, 255, 255, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect qTop = {block.x + 10, block.y + 6, 12, 8};
-    SDL_RenderFillRect(renderer, &qTop);
+    batch.fillRect(qTop);
     SDL_Rect qMid = {block.x + 14, block.y + 12, 8, 6};
-    SDL_RenderFillRect(renderer, &qMid);
+    batch.fillRect(qMid);
     SDL_Rect qDot = {block.x + 14, block.y + 20, 6, 6};
-    SDL_RenderFillRect(renderer, &qDot);
+    batch.fillRect(qDot);
 }
 
-void Menu::renderPipe(SDL_Renderer* renderer, int x, int y) {
+void Menu::renderPipe(int x, int y) {
     int width = 60;
     int height = 60;
     
     // Pipe top (darker green)
-    SDL_SetRenderDrawColor(renderer, 80, 180, 80, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(80, 180, 80, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect top = {x - 5, y, width + 10, 12};
-    SDL_RenderFillRect(renderer, &top);
+    batch.fillRect(top);
     
     // Pipe top highlight
-    SDL_SetRenderDrawColor(renderer, 120, 220, 120, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(120, 220, 120, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect topHighlight = {x - 3, y + 2, width + 6, 4};
-    SDL_RenderFillRect(renderer, &topHighlight);
+    batch.fillRect(topHighlight);
     
     // Pipe body
-    SDL_SetRenderDrawColor(renderer, 90, 190, 90, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(90, 190, 90, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect body = {x, y + 12, width, height};
-    SDL_RenderFillRect(renderer, &body);
+    batch.fillRect(body);
     
     // Pipe highlight (left side)
-    SDL_SetRenderDrawColor(renderer, 130, 230, 130, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(130, 230, 130, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect bodyHighlight = {x + 4, y + 14, 10, height - 2};
-    SDL_RenderFillRect(renderer, &bodyHighlight);
+    batch.fillRect(bodyHighlight);
     
     // Pipe shadow (right side)
-    SDL_SetRenderDrawColor(renderer, 60, 140, 60, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(60, 140, 60, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect bodyShadow = {x + width - 14, y + 14, 10, height - 2};
-    SDL_RenderFillRect(renderer, &bodyShadow);
+    batch.fillRect(bodyShadow);
     
     // Borders
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(255 * fadeIn));
-    SDL_RenderDrawRect(renderer, &top);
-    SDL_RenderDrawRect(renderer, &body);
+    batch.setColor(0, 0, 0, static_cast<Uint8>(255 * fadeIn));
+    batch.drawRect(top);
+    batch.drawRect(body);
 }
 
 void Menu::renderTitle(SDL_Renderer* renderer) {
@@ -401,17 +391,52 @@ void Menu::renderMenuItem(SDL_Renderer* renderer, MenuItem& item, bool isSelecte
     SDL_Rect& r = item.rect;
     float anim = easeInOutCubic(item.selectAnim);
     
+    if (!staticLayer) {
+        renderButton(r, isSelected);
+    } else if (isSelected && selectedButton) {
+        // Idle buttons are in the static layer; cover this one
+        batch.flush();
+        SDL_RenderCopy(renderer, selectedButton, nullptr, &r);
+    }
+    
+    // Selection indicators - Mario stars
+    if (isSelected) {
+        float starBounce = std::sin(pulsePhase * 4.0f) * 4.0f;
+        int midY = r.y + r.h / 2;
+        
+        // Left indicator
+        renderStar(r.x - 30, midY + static_cast<int>(starBounce));
+        
+        // Right indicator
+        renderStar(r.x + r.w + 20, midY + static_cast<int>(starBounce));
+    }
+    
+    // Text
+    if (itemFont) {
+        SDL_Color textColor;
+        if (isSelected) {
+            textColor = {255, 255, 255, static_cast<Uint8>(255 * fadeIn)};
+        } else {
+            textColor = {245, 235, 215, static_cast<Uint8>(240 * fadeIn)};
+        }
+        
+        renderText(renderer, item.text.c_str(), r.x + r.w / 2, 
+                r.y + r.h / 2 - 10, itemFont, textColor, true);
+    }
+}
+
+void Menu::renderButton(const SDL_Rect& r, bool isSelected) {
     // Brick platform style (matching game)
     int brickW = 16;
     int brickH = 16;
     
     // Base color
     if (isSelected) {
-        SDL_SetRenderDrawColor(renderer, 210, 130, 90, static_cast<Uint8>(255 * fadeIn));
+        batch.setColor(210, 130, 90, static_cast<Uint8>(255 * fadeIn));
     } else {
-        SDL_SetRenderDrawColor(renderer, 184, 111, 80, static_cast<Uint8>(230 * fadeIn));
+        batch.setColor(184, 111, 80, static_cast<Uint8>(230 * fadeIn));
     }
-    SDL_RenderFillRect(renderer, &r);
+    batch.fillRect(r);
     
     // Brick pattern with proper clipping
     for (int by = 0; by < r.h; by += brickH) {
@@ -438,7 +463,7 @@ void Menu::renderMenuItem(SDL_Renderer* renderer, MenuItem& item, bool isSelecte
             
             if (clippedWidth > 0 && clippedHeight > 0) {
                 // Brick highlight (top-left)
-                SDL_SetRenderDrawColor(renderer, 
+                batch.setColor(
                     isSelected ? 230 : 210, 
                     isSelected ? 160 : 140, 
                     isSelected ? 110 : 100, 
@@ -446,134 +471,126 @@ void Menu::renderMenuItem(SDL_Renderer* renderer, MenuItem& item, bool isSelecte
                 
                 if (clippedHeight > 2) {
                     SDL_Rect highlight = {brickStartX, brickStartY, clippedWidth - 2, 2};
-                    SDL_RenderFillRect(renderer, &highlight);
+                    batch.fillRect(highlight);
                 }
                 if (clippedWidth > 2) {
                     SDL_Rect highlightL = {brickStartX, brickStartY, 2, clippedHeight - 2};
-                    SDL_RenderFillRect(renderer, &highlightL);
+                    batch.fillRect(highlightL);
                 }
                 
                 // Brick shadow (bottom-right)
-                SDL_SetRenderDrawColor(renderer, 140, 80, 60, static_cast<Uint8>(200 * fadeIn));
+                batch.setColor(140, 80, 60, static_cast<Uint8>(200 * fadeIn));
                 if (clippedHeight > 2 && clippedWidth > 4) {
                     SDL_Rect shadow = {brickStartX + 2, brickStartY + clippedHeight - 2, clippedWidth - 2, 2};
-                    SDL_RenderFillRect(renderer, &shadow);
+                    batch.fillRect(shadow);
                 }
                 if (clippedWidth > 2 && clippedHeight > 4) {
                     SDL_Rect shadowR = {brickStartX + clippedWidth - 2, brickStartY + 2, 2, clippedHeight - 2};
-                    SDL_RenderFillRect(renderer, &shadowR);
+                    batch.fillRect(shadowR);
                 }
                 
                 // Mortar lines (dark lines between bricks)
-                SDL_SetRenderDrawColor(renderer, 100, 70, 50, static_cast<Uint8>(150 * fadeIn));
+                batch.setColor(100, 70, 50, static_cast<Uint8>(150 * fadeIn));
                 if (brickEndY <= r.y + r.h) {
                     SDL_Rect mortarH = {brickStartX, brickStartY + clippedHeight - 1, clippedWidth, 1};
-                    SDL_RenderFillRect(renderer, &mortarH);
+                    batch.fillRect(mortarH);
                 }
                 if (brickEndX <= r.x + r.w) {
                     SDL_Rect mortarV = {brickStartX + clippedWidth - 1, brickStartY, 1, clippedHeight};
-                    SDL_RenderFillRect(renderer, &mortarV);
+                    batch.fillRect(mortarV);
                 }
             }
         }
     }
     
     // Outer border
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, static_cast<Uint8>(255 * fadeIn));
-    SDL_RenderDrawRect(renderer, &r);
-    
-    // Selection indicators - Mario stars
-    if (isSelected) {
-        float starBounce = std::sin(pulsePhase * 4.0f) * 4.0f;
-        int midY = r.y + r.h / 2;
-        
-        // Left indicator
-        renderStar(renderer, r.x - 30, midY + static_cast<int>(starBounce));
-        
-        // Right indicator
-        renderStar(renderer, r.x + r.w + 20, midY + static_cast<int>(starBounce));
-    }
-    
-    // Text
-    if (itemFont) {
-        SDL_Color textColor;
-        if (isSelected) {
-            textColor = {255, 255, 255, static_cast<Uint8>(255 * fadeIn)};
-        } else {
-            textColor = {245, 235, 215, static_cast<Uint8>(240 * fadeIn)};
-        }
-        
-        renderText(renderer, item.text.c_str(), r.x + r.w / 2, 
-                r.y + r.h / 2 - 10, itemFont, textColor, true);
-    }
+    batch.setColor(0, 0, 0, static_cast<Uint8>(255 * fadeIn));
+    batch.drawRect(r);
 }
 
-void Menu::renderStar(SDL_Renderer* renderer, int x, int y) {
+void Menu::renderStar(int x, int y) {
     int size = 16;
     
     // Yellow star body
-    SDL_SetRenderDrawColor(renderer, 255, 220, 0, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(255, 220, 0, static_cast<Uint8>(255 * fadeIn));
     
     // Simple star shape using rectangles
     SDL_Rect center = {x - size/4, y - size/4, size/2, size/2};
-    SDL_RenderFillRect(renderer, &center);
+    batch.fillRect(center);
     
     // Points
     SDL_Rect top = {x - size/8, y - size/2, size/4, size/3};
-    SDL_RenderFillRect(renderer, &top);
+    batch.fillRect(top);
     
     SDL_Rect bottom = {x - size/8, y + size/6, size/4, size/3};
-    SDL_RenderFillRect(renderer, &bottom);
+    batch.fillRect(bottom);
     
     SDL_Rect left = {x - size/2, y - size/8, size/3, size/4};
-    SDL_RenderFillRect(renderer, &left);
+    batch.fillRect(left);
     
     SDL_Rect right = {x + size/6, y - size/8, size/3, size/4};
-    SDL_RenderFillRect(renderer, &right);
+    batch.fillRect(right);
     
     // Inner glow
-    SDL_SetRenderDrawColor(renderer, 255, 250, 200, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(255, 250, 200, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect glow = {x - size/6, y - size/6, size/3, size/3};
-    SDL_RenderFillRect(renderer, &glow);
+    batch.fillRect(glow);
 }
 
-void Menu::renderCoin(SDL_Renderer* renderer, int x, int y, float rotation) {
+void Menu::renderCoin(int x, int y, float rotation) {
     int size = 20;
     float scale = std::abs(std::cos(rotation));
     int width = static_cast<int>(size * scale);
     if (width < 4) width = 4;
     
     // Gold coin
-    SDL_SetRenderDrawColor(renderer, 255, 215, 0, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(255, 215, 0, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect coin = {x - width / 2, y - size / 2, width, size};
-    SDL_RenderFillRect(renderer, &coin);
+    batch.fillRect(coin);
     
     // Inner darker gold
-    SDL_SetRenderDrawColor(renderer, 218, 165, 32, static_cast<Uint8>(255 * fadeIn));
+    batch.setColor(218, 165, 32, static_cast<Uint8>(255 * fadeIn));
     SDL_Rect innerCoin = {x - width / 2 + 2, y - 6, width > 4 ? width - 4 : 2, 12};
-    SDL_RenderFillRect(renderer, &innerCoin);
+    batch.fillRect(innerCoin);
     
     // Shine highlight
     if (width > 6) {
-        SDL_SetRenderDrawColor(renderer, 255, 250, 205, static_cast<Uint8>(255 * fadeIn));
+        batch.setColor(255, 250, 205, static_cast<Uint8>(255 * fadeIn));
         SDL_Rect shine = {x - width / 2 + 2, y - 6, width / 3, 4};
-        SDL_RenderFillRect(renderer, &shine);
+        batch.fillRect(shine);
     }
     
     // Border
-    SDL_SetRenderDrawColor(renderer, 184, 134, 11, static_cast<Uint8>(255 * fadeIn));
-    SDL_RenderDrawRect(renderer, &coin);
+    batch.setColor(184, 134, 11, static_cast<Uint8>(255 * fadeIn));
+    batch.drawRect(coin);
 }
 
 void Menu::renderFooter(SDL_Renderer* renderer) {
     if (smallFont) {
         // Controls info
         SDL_Color white = {255, 255, 255, static_cast<Uint8>(220 * fadeIn)};
-        renderText(renderer, "Controls: Arrow Keys or WASD to navigate", 
-                windowWidth / 2, windowHeight - 45, smallFont, white, true);
+        if (loading) {
+            // One to three dots, cycling with the pulse
+            int dots = 1 + static_cast<int>(pulsePhase / (2.0f * M_PI) * 3.0f) % 3;
+            const char* text[] = {"LOADING.", "LOADING..", "LOADING..."};
+            renderText(renderer, text[dots - 1], 
+                    windowWidth / 2, windowHeight - 35, smallFont, white, true);
+        } else {
+            renderText(renderer, "Controls: Arrow Keys or WASD to navigate", 
+                    windowWidth / 2, windowHeight - 45, smallFont, white, true);
+            
+            renderText(renderer, "Press ENTER or SPACE to select", 
+                    windowWidth / 2, windowHeight - 25, smallFont, white, true);
+        }
         
-        renderText(renderer, "Press ENTER or SPACE to select", 
-                windowWidth / 2, windowHeight - 25, smallFont, white, true);
+        // Render stats of the previous frame (F3)
+        if (showRenderStats) {
+            const RenderBatch::Stats& stats = batch.getFrameStats();
+            char statsText[64];
+            snprintf(statsText, sizeof(statsText), "BATCHES: %d  VERTS: %d",
+                     stats.batches, stats.vertices);
+            renderText(renderer, statsText, 10, 10, smallFont, white, false);
+        }
     }
 }
 
@@ -581,19 +598,11 @@ void Menu::renderText(SDL_Renderer* renderer, const char* text, int x, int y,
                     TTF_Font* font, SDL_Color color, bool centered) {
     if (!font) return;
     
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
-    if (surface) {
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_Rect rect = {
-            centered ? x - surface->w / 2 : x,
-            y,
-            surface->w,
-            surface->h
-        };
-        SDL_RenderCopy(renderer, texture, nullptr, &rect);
-        SDL_DestroyTexture(texture);
-        SDL_FreeSurface(surface);
-    }
+    // Text is textured, so pending shapes must go out first
+    batch.flush();
+    
+    // Glyphs come from the shared atlas, no per-frame rasterization
+    TextCache::instance().renderText(renderer, font, text, x, y, color, centered);
 }
 
 float Menu::easeInOutCubic(float t) {
@@ -609,21 +618,80 @@ SDL_Color Menu::lerpColor(SDL_Color a, SDL_Color b, float t) {
     };
 }
 
+bool Menu::buildStaticLayer(SDL_Renderer* renderer) {
+    releaseStaticLayer();
+    if (items.empty()) return false;
+    
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    
+    staticLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, windowWidth, windowHeight);
+    SDL_Rect buttonRect = {0, 0, items[0].rect.w, items[0].rect.h};
+    selectedButton = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                       SDL_TEXTUREACCESS_TARGET, buttonRect.w, buttonRect.h);
+    if (!staticLayer || !selectedButton || SDL_SetRenderTarget(renderer, staticLayer) != 0) {
+        LOG_WARN("Menu static layer unavailable, drawing it every frame: %s", SDL_GetError());
+        releaseStaticLayer();
+        return false;
+    }
+    
+    // Shapes blended onto a transparent target end up premultiplied by
+    // their alpha (the idle buttons are translucent), so composite the
+    // textures with a premultiplied blend where the renderer supports it
+    SDL_BlendMode blend = SDL_BLENDMODE_BLEND;
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+    blend = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+#endif
+    if (SDL_SetTextureBlendMode(staticLayer, blend) != 0 ||
+        SDL_SetTextureBlendMode(selectedButton, blend) != 0) {
+        SDL_SetTextureBlendMode(staticLayer, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureBlendMode(selectedButton, SDL_BLENDMODE_BLEND);
+    }
+    
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    renderGround();
+    renderPipe(80, windowHeight - 140);
+    renderPipe(windowWidth - 120, windowHeight - 140);
+    for (const auto& item : items) {
+        renderButton(item.rect, false);
+    }
+    batch.flush();
+    
+    SDL_SetRenderTarget(renderer, selectedButton);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    renderButton(buttonRect, true);
+    batch.flush();
+    
+    SDL_SetRenderTarget(renderer, previousTarget);
+    return true;
+}
+
+void Menu::releaseStaticLayer() {
+    if (staticLayer) SDL_DestroyTexture(staticLayer);
+    if (selectedButton) SDL_DestroyTexture(selectedButton);
+    staticLayer = nullptr;
+    selectedButton = nullptr;
+    staticLayerFailed = false;
+}
+
 void Menu::renderMushroom(SDL_Renderer* renderer, int x, int y) {
     // Not used in new design, but kept for compatibility
 }
 
 void Menu::cleanup() {
-    if (titleFont) {
-        TTF_CloseFont(titleFont);
-        titleFont = nullptr;
-    }
-    if (itemFont) {
-        TTF_CloseFont(itemFont);
-        itemFont = nullptr;
-    }
-    if (smallFont) {
-        TTF_CloseFont(smallFont);
-        smallFont = nullptr;
-    }
+    ResourceManager& resources = ResourceManager::instance();
+    resources.releaseFont(titleFont);
+    resources.releaseFont(itemFont);
+    resources.releaseFont(smallFont);
+    titleFont = nullptr;
+    itemFont = nullptr;
+    smallFont = nullptr;
+    
+    skyLayer.release();
+    parallax.release();
+    releaseStaticLayer();
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "ParallaxLayers.h"
+#include "Log.h"
+#include "TileTextures.h"
+#include <cmath>
+
+static const float TWO_PI = 2.0f * 3.14159f;
+
+// Per-layer constants. Content is drawn fully opaque; a layer's
+// translucency comes from its base alpha, applied when drawing.
+struct LayerSpec {
+  int period;
+  int height;
+  float scroll;
+  Uint8 baseAlpha;
+};
+
+static const LayerSpec LAYER_SPECS[static_cast<int>(ParallaxKind::COUNT)] = {
+    {1024, 300, 0.02f, 255}, // STARS
+    {1200, 200, 0.1f, 170},  // FAR_CLOUDS
+    {1600, 140, 0.2f, 255},  // HILLS
+    {1750, 260, 0.3f, 255},  // NEAR_CLOUDS
+};
+
+static Uint8 modulate(int value, Uint8 amount) {
+  return static_cast<Uint8>(value * amount / 255);
+}
+
+// Fills `rect` and, where it runs past the right edge, its wrapped copy
+// on the left, so the content tiles seamlessly every `width` pixels
+static void fillWrapped(SDL_Renderer *renderer, SDL_Rect rect, int originX,
+                        int width) {
+  rect.x += originX;
+  SDL_RenderFillRect(renderer, &rect);
+  if (rect.x + rect.w > originX + width) {
+    rect.x -= width;
+    SDL_RenderFillRect(renderer, &rect);
+  }
+}
+
+// Same three-part cloud as the menu used to draw, scaled
+static void drawCloud(SDL_Renderer *renderer, int x, int y, float scale,
+                      int originX, int width) {
+  SDL_Rect body = {x, y + static_cast<int>(10 * scale),
+                   static_cast<int>(50 * scale), static_cast<int>(25 * scale)};
+  SDL_Rect left = {x + static_cast<int>(10 * scale), y,
+                   static_cast<int>(35 * scale), static_cast<int>(30 * scale)};
+  SDL_Rect right = {x + static_cast<int>(30 * scale),
+                    y + static_cast<int>(5 * scale),
+                    static_cast<int>(40 * scale),
+                    static_cast<int>(28 * scale)};
+  fillWrapped(renderer, body, originX, width);
+  fillWrapped(renderer, left, originX, width);
+  fillWrapped(renderer, right, originX, width);
+}
+
+// Height of a hill ridge at x, periodic in `period`. Only whole numbers of
+// waves fit in a period, so the ridge joins up where the layer wraps.
+static int ridgeHeight(int x, int period, int height, float base, int wave1,
+                       float amp1, int wave2, float amp2, float shift) {
+  float u = static_cast<float>(x) / period * TWO_PI;
+  float h = base + amp1 * sin(u * wave1 + shift) + amp2 * sin(u * wave2);
+  return static_cast<int>(h * height);
+}
+
+ParallaxLayers::ParallaxLayers() : viewWidth(0), viewHeight(0) {
+  for (int i = 0; i < static_cast<int>(ParallaxKind::COUNT); i++) {
+    layers[i].texture = nullptr;
+    layers[i].period = LAYER_SPECS[i].period;
+    layers[i].width = 0;
+    layers[i].y = 0;
+    layers[i].height = LAYER_SPECS[i].height;
+  }
+}
+
+ParallaxLayers::~ParallaxLayers() { release(); }
+
+void ParallaxLayers::release() {
+  for (int i = 0; i < static_cast<int>(ParallaxKind::COUNT); i++) {
+    if (layers[i].texture)
+      SDL_DestroyTexture(layers[i].texture);
+    layers[i].texture = nullptr;
+  }
+  viewWidth = 0;
+  viewHeight = 0;
+}
+
+float ParallaxLayers::scrollFactor(ParallaxKind kind) {
+  return LAYER_SPECS[static_cast<int>(kind)].scroll;
+}
+
+void ParallaxLayers::drawLayer(SDL_Renderer *renderer, ParallaxKind kind,
+                               const Layer &layer, int originX, int originY,
+                               Uint8 brightness, Uint8 alpha) {
+  const int width = layer.width;
+  const int copies = width / layer.period;
+
+  switch (kind) {
+  case ParallaxKind::STARS:
+    SDL_SetRenderDrawColor(renderer, modulate(210, brightness),
+                           modulate(210, brightness),
+                           modulate(235, brightness), alpha);
+    for (int c = 0; c < copies; c++) {
+      for (int i = 0; i < 140; i++) {
+        int size = i % 7 == 0 ? 2 : 1;
+        SDL_Rect star = {c * layer.period + (i * 211 + 17) % layer.period,
+                         originY + (i * 97 + 11) % layer.height, size, size};
+        fillWrapped(renderer, star, originX, width);
+      }
+    }
+    break;
+
+  case ParallaxKind::FAR_CLOUDS:
+    SDL_SetRenderDrawColor(renderer, modulate(235, brightness),
+                           modulate(240, brightness),
+                           modulate(255, brightness), alpha);
+    for (int c = 0; c < copies; c++) {
+      for (int i = 0; i < 8; i++) {
+        int x = c * layer.period + i * 150 + (i * 53) % 70;
+        int y = originY + 20 + (i * 37) % 110;
+        drawCloud(renderer, x, y, 0.6f, originX, width);
+      }
+    }
+    break;
+
+  case ParallaxKind::HILLS:
+    for (int x = 0; x < width; x += 4) {
+      int back = ridgeHeight(x, layer.period, layer.height, 0.6f, 2, 0.25f,
+                             5, 0.12f, 1.0f);
+      int front = ridgeHeight(x, layer.period, layer.height, 0.35f, 3, 0.2f,
+                              7, 0.08f, 2.0f);
+
+      // Far ridge, paler, then the nearer one over it
+      SDL_SetRenderDrawColor(renderer, modulate(150, brightness),
+                             modulate(200, brightness),
+                             modulate(150, brightness), alpha);
+      SDL_Rect backRect = {originX + x, originY + layer.height - back, 4, back};
+      SDL_RenderFillRect(renderer, &backRect);
+
+      SDL_SetRenderDrawColor(renderer, modulate(105, brightness),
+                             modulate(170, brightness),
+                             modulate(90, brightness), alpha);
+      SDL_Rect frontRect = {originX + x, originY + layer.height - front, 4,
+                            front};
+      SDL_RenderFillRect(renderer, &frontRect);
+    }
+    break;
+
+  case ParallaxKind::NEAR_CLOUDS:
+    SDL_SetRenderDrawColor(renderer, brightness, brightness, brightness,
+                           alpha);
+    for (int c = 0; c < copies; c++) {
+      for (int i = 0; i < 5; i++) {
+        int x = c * layer.period + 200 + i * 350;
+        int y = originY + 80 + i * 30;
+        drawCloud(renderer, x, y, 1.0f, originX, width);
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+bool ParallaxLayers::bake(SDL_Renderer *renderer, int width, int height) {
+  release();
+  viewWidth = width;
+  viewHeight = height;
+
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+  bool ok = true;
+  for (int i = 0; i < static_cast<int>(ParallaxKind::COUNT); i++) {
+    ParallaxKind kind = static_cast<ParallaxKind>(i);
+    Layer &layer = layers[i];
+
+    // Whole periods, enough to cover the view
+    int copies = (width + layer.period - 1) / layer.period;
+    if (copies < 1)
+      copies = 1;
+    layer.width = copies * layer.period;
+    layer.y = kind == ParallaxKind::HILLS
+                  ? height - TileTextures::GROUND_HEIGHT - layer.height
+                  : 0;
+
+    SDL_Texture *texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                          SDL_TEXTUREACCESS_TARGET, layer.width, layer.height);
+    if (!texture || SDL_SetRenderTarget(renderer, texture) != 0) {
+      if (texture)
+        SDL_DestroyTexture(texture);
+      ok = false;
+      continue;
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    drawLayer(renderer, kind, layer, 0, 0, 255, 255);
+    layer.texture = texture;
+  }
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+  if (!ok) {
+    LOG_WARN("Parallax baking unavailable, drawing layers directly: %s",
+             SDL_GetError());
+  }
+  return ok;
+}
+
+void ParallaxLayers::draw(SDL_Renderer *renderer, ParallaxKind kind,
+                          float cameraX, Uint8 brightness, Uint8 alpha) {
+  if (!isBaked() || alpha == 0)
+    return;
+
+  const Layer &layer = layers[static_cast<int>(kind)];
+  Uint8 layerAlpha = modulate(LAYER_SPECS[static_cast<int>(kind)].baseAlpha,
+                              alpha);
+
+  // Left edge of the view inside the wrapping layer
+  float scrolled = fmod(cameraX * scrollFactor(kind),
+                        static_cast<float>(layer.width));
+  if (scrolled < 0.0f)
+    scrolled += layer.width;
+  int offset = static_cast<int>(scrolled);
+
+  if (layer.texture) {
+    SDL_SetTextureColorMod(layer.texture, brightness, brightness, brightness);
+    SDL_SetTextureAlphaMod(layer.texture, layerAlpha);
+
+    SDL_Rect src = {offset, 0, layer.width - offset, layer.height};
+    SDL_Rect dst = {0, layer.y, src.w, layer.height};
+    SDL_RenderCopy(renderer, layer.texture, &src, &dst);
+
+    // The wrapped-around start of the layer fills the rest of the view
+    if (dst.w < viewWidth) {
+      SDL_Rect wrapSrc = {0, 0, viewWidth - dst.w, layer.height};
+      SDL_Rect wrapDst = {dst.w, layer.y, wrapSrc.w, layer.height};
+      SDL_RenderCopy(renderer, layer.texture, &wrapSrc, &wrapDst);
+    }
+  } else {
+    drawLayer(renderer, kind, layer, -offset, layer.y, brightness,
+              layerAlpha);
+    if (layer.width - offset < viewWidth)
+      drawLayer(renderer, kind, layer, layer.width - offset, layer.y,
+                brightness, layerAlpha);
+  }
+}
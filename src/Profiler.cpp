@@ -0,0 +1,213 @@
+#include "Profiler.h"
+#include "Log.h"
+#include "RenderBatch.h"
+#include "TextCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const int OVERLAY_WIDTH = 300;
+static const int GRAPH_HEIGHT = 60;
+static const float GRAPH_MAX_MS = 33.3f; // Top of the graph, 30 fps
+static const float TARGET_MS = 16.7f;    // 60 fps line
+
+Profiler &Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler()
+    : frequency(static_cast<double>(SDL_GetPerformanceFrequency())),
+      frameStart(0), traceOrigin(SDL_GetPerformanceCounter()), frameCount(0),
+      trace(TRACE_CAPACITY), traceNext(0), traceWrapped(false),
+      overlayVisible(false) {
+  std::fill(frameHistory, frameHistory + GRAPH_FRAMES, 0.0f);
+}
+
+double Profiler::toMs(Uint64 ticks) const {
+  return static_cast<double>(ticks) * 1000.0 / frequency;
+}
+
+Profiler::Zone &Profiler::findZone(const char *name) {
+  // Few zones, and names are literals, so the pointer check nearly always
+  // hits first
+  for (size_t i = 0; i < zones.size(); i++) {
+    if (zones[i].name == name || strcmp(zones[i].name, name) == 0)
+      return zones[i];
+  }
+
+  Zone zone;
+  zone.name = name;
+  zone.frameTicks = 0;
+  std::fill(zone.history, zone.history + HISTORY_FRAMES, 0.0f);
+  zones.push_back(zone);
+  return zones.back();
+}
+
+void Profiler::record(const char *name, Uint64 start, Uint64 end) {
+  findZone(name).frameTicks += end - start;
+
+  TraceEvent &event = trace[traceNext];
+  event.name = name;
+  event.start = start;
+  event.end = end;
+  if (++traceNext == trace.size()) {
+    traceNext = 0;
+    traceWrapped = true;
+  }
+}
+
+void Profiler::frame() {
+  Uint64 now = SDL_GetPerformanceCounter();
+
+  if (frameStart != 0) {
+    int slot = frameCount % HISTORY_FRAMES;
+    for (size_t i = 0; i < zones.size(); i++) {
+      zones[i].history[slot] = static_cast<float>(toMs(zones[i].frameTicks));
+      zones[i].frameTicks = 0;
+    }
+    frameHistory[frameCount % GRAPH_FRAMES] =
+        static_cast<float>(toMs(now - frameStart));
+    frameCount++;
+
+    // Whole frames show up as the outermost events in the trace
+    record("frame", frameStart, now);
+    findZone("frame").frameTicks = 0;
+  }
+
+  frameStart = now;
+}
+
+void Profiler::summarize(const float *history, float *average, float *p99) {
+  int count = std::min(frameCount, static_cast<int>(HISTORY_FRAMES));
+  if (count == 0) {
+    *average = 0.0f;
+    *p99 = 0.0f;
+    return;
+  }
+
+  sortScratch.assign(history, history + count);
+  float sum = 0.0f;
+  for (int i = 0; i < count; i++)
+    sum += sortScratch[i];
+  *average = sum / count;
+
+  // Smallest sample that at least 99% of the frames are at or below
+  int rank = (count * 99 + 99) / 100 - 1;
+  std::nth_element(sortScratch.begin(), sortScratch.begin() + rank,
+                   sortScratch.end());
+  *p99 = sortScratch[rank];
+}
+
+void Profiler::drawOverlay(RenderBatch &batch, TTF_Font *font, int x, int y) {
+  if (!font)
+    return;
+
+  SDL_Renderer *renderer = batch.getRenderer();
+  int lineHeight = TTF_FontHeight(font) + 2;
+
+  // The "frame" zone is the header line, not a table row
+  int rows = 2; // Header and column titles
+  for (size_t i = 0; i < zones.size(); i++) {
+    if (strcmp(zones[i].name, "frame") != 0)
+      rows++;
+  }
+  int tableHeight = rows * lineHeight + 8;
+  int height = tableHeight + GRAPH_HEIGHT + 8;
+
+  // Shapes first, then all text on top of them
+  batch.setColor(0, 0, 0, 180);
+  SDL_Rect background = {x, y, OVERLAY_WIDTH, height};
+  batch.fillRect(background);
+
+  int graphBottom = y + height - 4;
+  int graphCount = std::min(frameCount, static_cast<int>(GRAPH_FRAMES));
+  int barWidth = std::max(1, (OVERLAY_WIDTH - 8) / GRAPH_FRAMES);
+  for (int i = 0; i < graphCount; i++) {
+    // Oldest on the left
+    int frameIndex = frameCount - graphCount + i;
+    float ms = frameHistory[frameIndex % GRAPH_FRAMES];
+    int barHeight = static_cast<int>(std::min(ms / GRAPH_MAX_MS, 1.0f) *
+                                     GRAPH_HEIGHT);
+    if (ms <= TARGET_MS)
+      batch.setColor(80, 220, 80, 255);
+    else if (ms <= GRAPH_MAX_MS)
+      batch.setColor(240, 200, 40, 255);
+    else
+      batch.setColor(230, 60, 60, 255);
+    SDL_Rect bar = {x + 4 + i * barWidth, graphBottom - barHeight, barWidth,
+                    barHeight};
+    batch.fillRect(bar);
+  }
+
+  int targetY =
+      graphBottom - static_cast<int>(TARGET_MS / GRAPH_MAX_MS * GRAPH_HEIGHT);
+  batch.setColor(255, 255, 255, 120);
+  batch.drawLine(x + 4, targetY, x + OVERLAY_WIDTH - 4, targetY);
+  batch.flush();
+
+  TextCache &textCache = TextCache::instance();
+  SDL_Color white = {255, 255, 255, 255};
+  SDL_Color gray = {180, 180, 180, 255};
+  char text[64];
+  float average, p99;
+
+  // frameHistory is the longer graph ring; summarize its latest frames
+  float recent[HISTORY_FRAMES];
+  int recentCount = std::min(frameCount, static_cast<int>(HISTORY_FRAMES));
+  for (int i = 0; i < recentCount; i++)
+    recent[i] = frameHistory[(frameCount - 1 - i) % GRAPH_FRAMES];
+  summarize(recent, &average, &p99);
+  snprintf(text, sizeof(text), "FRAME %.2f MS  P99 %.2f", average, p99);
+  int lineY = y + 4;
+  textCache.renderText(renderer, font, text, x + 6, lineY, white, false);
+  lineY += lineHeight;
+
+  textCache.renderText(renderer, font, "ZONE", x + 6, lineY, gray, false);
+  textCache.renderText(renderer, font, "AVG", x + 170, lineY, gray, false);
+  textCache.renderText(renderer, font, "P99", x + 235, lineY, gray, false);
+  lineY += lineHeight;
+
+  for (size_t i = 0; i < zones.size(); i++) {
+    if (strcmp(zones[i].name, "frame") == 0)
+      continue;
+    summarize(zones[i].history, &average, &p99);
+    textCache.renderText(renderer, font, zones[i].name, x + 6, lineY, white,
+                         false);
+    snprintf(text, sizeof(text), "%.2f", average);
+    textCache.renderText(renderer, font, text, x + 170, lineY, white, false);
+    snprintf(text, sizeof(text), "%.2f", p99);
+    textCache.renderText(renderer, font, text, x + 235, lineY, white, false);
+    lineY += lineHeight;
+  }
+}
+
+bool Profiler::exportChromeTrace(const std::string &path) const {
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file) {
+    LOG_ERROR("Cannot write trace: %s", path.c_str());
+    return false;
+  }
+
+  // Oldest event first
+  size_t count = traceWrapped ? trace.size() : traceNext;
+  size_t first = traceWrapped ? traceNext : 0;
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  for (size_t i = 0; i < count; i++) {
+    const TraceEvent &event = trace[(first + i) % trace.size()];
+    double ts = toMs(event.start - traceOrigin) * 1000.0;
+    double dur = toMs(event.end - event.start) * 1000.0;
+    fprintf(file,
+            "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+            "\"ts\":%.3f,\"dur\":%.3f}%s\n",
+            event.name, ts, dur, i + 1 < count ? "," : "");
+  }
+  fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+
+  bool ok = ferror(file) == 0;
+  fclose(file);
+  LOG_INFO("Wrote %lu trace events to %s", static_cast<unsigned long>(count),
+           path.c_str());
+  return ok;
+}
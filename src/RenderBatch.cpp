@@ -0,0 +1,158 @@
+#include "RenderBatch.h"
+#include <cmath>
+#include <cstdlib>
+
+RenderBatch::RenderBatch() : renderer(nullptr) {
+  color = {255, 255, 255, 255};
+  current = {0, 0, 0};
+  lastFrame = {0, 0, 0};
+}
+
+RenderBatch::RenderBatch(SDL_Renderer *r) : RenderBatch() { renderer = r; }
+
+void RenderBatch::setRenderer(SDL_Renderer *r) {
+  if (renderer != r)
+    flush();
+  renderer = r;
+}
+
+void RenderBatch::setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+  color = {r, g, b, a};
+}
+
+void RenderBatch::fillRect(const SDL_Rect &rect) {
+  if (rect.w <= 0 || rect.h <= 0)
+    return;
+  Primitive p = {rect, color, false};
+  pending.push_back(p);
+  current.primitives++;
+}
+
+void RenderBatch::drawRect(const SDL_Rect &rect) {
+  if (rect.w <= 0 || rect.h <= 0)
+    return;
+
+  // Same pixels as SDL_RenderDrawRect: top, bottom, left, right edges
+  SDL_Rect top = {rect.x, rect.y, rect.w, 1};
+  SDL_Rect bottom = {rect.x, rect.y + rect.h - 1, rect.w, 1};
+  SDL_Rect left = {rect.x, rect.y + 1, 1, rect.h - 2};
+  SDL_Rect right = {rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2};
+  fillRect(top);
+  if (rect.h > 1)
+    fillRect(bottom);
+  fillRect(left);
+  if (rect.w > 1)
+    fillRect(right);
+}
+
+void RenderBatch::drawLine(int x0, int y0, int x1, int y1) {
+  // Axis-aligned lines are just thin rects
+  if (y0 == y1) {
+    SDL_Rect r = {x0 < x1 ? x0 : x1, y0, std::abs(x1 - x0) + 1, 1};
+    fillRect(r);
+    return;
+  }
+  if (x0 == x1) {
+    SDL_Rect r = {x0, y0 < y1 ? y0 : y1, 1, std::abs(y1 - y0) + 1};
+    fillRect(r);
+    return;
+  }
+
+  Primitive p = {{x0, y0, x1, y1}, color, true};
+  pending.push_back(p);
+  current.primitives++;
+}
+
+void RenderBatch::appendQuad(float x0, float y0, float x1, float y1, float x2,
+                             float y2, float x3, float y3, SDL_Color c) {
+  int base = static_cast<int>(vertices.size());
+  SDL_Vertex quad[4] = {{{x0, y0}, c, {0.0f, 0.0f}},
+                        {{x1, y1}, c, {0.0f, 0.0f}},
+                        {{x2, y2}, c, {0.0f, 0.0f}},
+                        {{x3, y3}, c, {0.0f, 0.0f}}};
+  vertices.insert(vertices.end(), quad, quad + 4);
+
+  int quadIndices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+  indices.insert(indices.end(), quadIndices, quadIndices + 6);
+}
+
+void RenderBatch::flush() {
+  if (pending.empty() || !renderer) {
+    pending.clear();
+    return;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  vertices.clear();
+  indices.clear();
+
+  for (const auto &p : pending) {
+    if (p.isLine) {
+      // One pixel wide quad centered on the line, through pixel centers
+      float ax = p.rect.x + 0.5f, ay = p.rect.y + 0.5f;
+      float bx = p.rect.w + 0.5f, by = p.rect.h + 0.5f;
+      float dx = bx - ax, dy = by - ay;
+      float len = std::sqrt(dx * dx + dy * dy);
+      float nx = -dy / len * 0.5f, ny = dx / len * 0.5f;
+      appendQuad(ax + nx, ay + ny, bx + nx, by + ny, bx - nx, by - ny,
+                 ax - nx, ay - ny, p.color);
+    } else {
+      float x0 = static_cast<float>(p.rect.x);
+      float y0 = static_cast<float>(p.rect.y);
+      float x1 = x0 + p.rect.w;
+      float y1 = y0 + p.rect.h;
+      appendQuad(x0, y0, x1, y0, x1, y1, x0, y1, p.color);
+    }
+  }
+
+  SDL_RenderGeometry(renderer, nullptr, vertices.data(),
+                     static_cast<int>(vertices.size()), indices.data(),
+                     static_cast<int>(indices.size()));
+  current.batches++;
+  current.vertices += static_cast<int>(vertices.size());
+#else
+  // Group consecutive same-colored rects; lines go through one by one
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+  size_t i = 0;
+  while (i < pending.size()) {
+    const Primitive &first = pending[i];
+    SDL_SetRenderDrawColor(renderer, first.color.r, first.color.g,
+                           first.color.b, first.color.a);
+
+    if (first.isLine) {
+      SDL_RenderDrawLine(renderer, first.rect.x, first.rect.y, first.rect.w,
+                         first.rect.h);
+      current.batches++;
+      current.vertices += 2;
+      i++;
+      continue;
+    }
+
+    rects.clear();
+    while (i < pending.size() && !pending[i].isLine &&
+           pending[i].color.r == first.color.r &&
+           pending[i].color.g == first.color.g &&
+           pending[i].color.b == first.color.b &&
+           pending[i].color.a == first.color.a) {
+      rects.push_back(pending[i].rect);
+      i++;
+    }
+
+    SDL_RenderFillRects(renderer, rects.data(), static_cast<int>(rects.size()));
+    current.batches++;
+    current.vertices += static_cast<int>(rects.size()) * 4;
+  }
+
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+#endif
+
+  pending.clear();
+}
+
+void RenderBatch::endFrame() {
+  flush();
+  lastFrame = current;
+  current = {0, 0, 0};
+}
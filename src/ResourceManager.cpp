@@ -0,0 +1,128 @@
+#include "ResourceManager.h"
+#include "TextCache.h"
+#include <iostream>
+
+// Tried in order by acquireUIFont
+static const char *const UI_FONT_PATHS[] = {
+    "assets/PressStart2P-Regular.ttf",
+    "assets/fonts/arial.ttf",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
+    "/usr/share/fonts/TTF/DejaVuSans-Bold.ttf",
+    "C:\\Windows\\Fonts\\arial.ttf"};
+
+ResourceManager &ResourceManager::instance() {
+  // Leaked like TextCache: fonts must be closed through shutdown() before
+  // TTF_Quit, not at static exit
+  static ResourceManager *manager = new ResourceManager();
+  return *manager;
+}
+
+bool ResourceManager::init() {
+  if (ttfInitialized)
+    return true;
+
+  if (TTF_Init() == -1) {
+    std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+    return false;
+  }
+  ttfInitialized = true;
+  return true;
+}
+
+void ResourceManager::shutdown() {
+  for (auto &entry : fonts) {
+    if (entry.second.refCount > 0) {
+      std::cerr << "Warning: font " << entry.first.first << " ("
+                << entry.first.second << "pt) still in use at shutdown"
+                << std::endl;
+    }
+    closeFont(entry.second.font);
+  }
+  fonts.clear();
+  keys.clear();
+  missingFiles.clear();
+  uiFontPath.clear();
+
+  if (ttfInitialized) {
+    TTF_Quit();
+    ttfInitialized = false;
+  }
+}
+
+void ResourceManager::closeFont(TTF_Font *font) {
+  // The glyph atlas is keyed by the font pointer, so it goes first
+  TextCache::instance().releaseFont(font);
+  TTF_CloseFont(font);
+}
+
+TTF_Font *ResourceManager::acquireFont(const std::string &path, int size) {
+  FontKey key(path, size);
+  std::map<FontKey, FontEntry>::iterator it = fonts.find(key);
+  if (it != fonts.end()) {
+    it->second.refCount++;
+    return it->second.font;
+  }
+
+  if (!init() || missingFiles.count(path))
+    return nullptr;
+
+  TTF_Font *font = TTF_OpenFont(path.c_str(), size);
+  if (!font) {
+    missingFiles.insert(path);
+    return nullptr;
+  }
+
+  FontEntry entry = {font, 1};
+  fonts[key] = entry;
+  keys[font] = key;
+  return font;
+}
+
+TTF_Font *ResourceManager::acquireUIFont(int size) {
+  if (!uiFontPath.empty()) {
+    TTF_Font *font = acquireFont(uiFontPath, size);
+    if (font)
+      return font;
+  }
+
+  for (const char *path : UI_FONT_PATHS) {
+    TTF_Font *font = acquireFont(path, size);
+    if (font) {
+      if (uiFontPath != path)
+        std::cout << "UI font: " << path << std::endl;
+      uiFontPath = path;
+      return font;
+    }
+  }
+
+  std::cerr << "Warning: no UI font could be loaded at " << size
+            << "pt. Install DejaVu fonts or add the PressStart2P font."
+            << std::endl;
+  return nullptr;
+}
+
+void ResourceManager::releaseFont(TTF_Font *font) {
+  if (!font)
+    return;
+
+  std::map<TTF_Font *, FontKey>::iterator key = keys.find(font);
+  if (key == keys.end())
+    return;
+
+  FontEntry &entry = fonts[key->second];
+  if (entry.refCount > 0)
+    entry.refCount--;
+}
+
+void ResourceManager::purgeUnused() {
+  std::map<FontKey, FontEntry>::iterator it = fonts.begin();
+  while (it != fonts.end()) {
+    if (it->second.refCount == 0) {
+      closeFont(it->second.font);
+      keys.erase(it->second.font);
+      fonts.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
@@ -0,0 +1,245 @@
+#include "SkyLayer.h"
+#include "RenderBatch.h"
+#include <cmath>
+
+static const float PI = 3.14159f;
+static const float TWO_PI = 2.0f * PI;
+
+// The sky lightens towards this color near the horizon
+static const SDL_Color HORIZON_TINT = {255, 140, 252, 255};
+static const float HORIZON_MIX = 0.3f;
+
+// Sun rays: start and end offsets from the sun's center
+struct SunRay {
+  int x0, y0, x1, y1;
+};
+
+static const SunRay *sunRays() {
+  static SunRay rays[8];
+  static bool built = false;
+  if (!built) {
+    for (int i = 0; i < 8; i++) {
+      float angle = i * PI / 4.0f;
+      rays[i].x0 = static_cast<int>(cos(angle) * 35);
+      rays[i].y0 = static_cast<int>(sin(angle) * 35);
+      rays[i].x1 = static_cast<int>(cos(angle) * 50);
+      rays[i].y1 = static_cast<int>(sin(angle) * 50);
+    }
+    built = true;
+  }
+  return rays;
+}
+
+SkyLayer::SkyLayer()
+    : texture(nullptr), textureRenderer(nullptr), cachedStep(-1),
+      cachedHeight(0), starWidth(0) {}
+
+SkyLayer::~SkyLayer() { release(); }
+
+void SkyLayer::release() {
+  if (texture)
+    SDL_DestroyTexture(texture);
+  texture = nullptr;
+  textureRenderer = nullptr;
+  cachedStep = -1;
+  cachedHeight = 0;
+}
+
+SDL_Color SkyLayer::skyColor(float dayTime) {
+  // dayTime: 0.0 = midnight, 0.25 = sunrise (6am), 0.5 = noon, 0.75 = sunset
+  // (6pm), 1.0 = midnight
+  int skyR, skyG, skyB;
+  if (dayTime < 0.25f) {
+    // Night to sunrise (midnight to 6am)
+    float t = dayTime / 0.25f;
+    skyR = static_cast<int>(25 + (255 - 25) * t);
+    skyG = static_cast<int>(25 + (140 - 25) * t);
+    skyB = static_cast<int>(112 + (252 - 112) * t);
+  } else if (dayTime < 0.5f) {
+    // Sunrise to noon (6am to 12pm)
+    float t = (dayTime - 0.25f) / 0.25f;
+    skyR = static_cast<int>(255 - (255 - 92) * t);
+    skyG = static_cast<int>(140 + (148 - 140) * t);
+    skyB = 252;
+  } else if (dayTime < 0.75f) {
+    // Noon to sunset (12pm to 6pm)
+    float t = (dayTime - 0.5f) / 0.25f;
+    skyR = static_cast<int>(92 + (255 - 92) * t);
+    skyG = static_cast<int>(148 - (148 - 100) * t);
+    skyB = static_cast<int>(252 - (252 - 150) * t);
+  } else {
+    // Sunset to night (6pm to midnight)
+    float t = (dayTime - 0.75f) / 0.25f;
+    skyR = static_cast<int>(255 - (255 - 25) * t);
+    skyG = static_cast<int>(100 - (100 - 25) * t);
+    skyB = static_cast<int>(150 - (150 - 112) * t);
+  }
+  SDL_Color color = {static_cast<Uint8>(skyR), static_cast<Uint8>(skyG),
+                     static_cast<Uint8>(skyB), 255};
+  return color;
+}
+
+float SkyLayer::starAlpha(float dayTime) {
+  if (dayTime < 0.3f)
+    return (0.3f - dayTime) / 0.3f;
+  if (dayTime > 0.7f)
+    return (dayTime - 0.7f) / 0.3f;
+  return 0.0f;
+}
+
+bool SkyLayer::updateTexture(SDL_Renderer *renderer, int step, int height) {
+  if (texture && textureRenderer == renderer && step == cachedStep &&
+      height == cachedHeight)
+    return true;
+
+  if (!texture || textureRenderer != renderer || height != cachedHeight) {
+    release();
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                SDL_TEXTUREACCESS_STREAMING, 1, height);
+    if (!texture)
+      return false;
+    textureRenderer = renderer;
+    cachedHeight = height;
+  }
+
+  // Middle of the step, so the cached sky is never more than half a step
+  // off
+  SDL_Color top = skyColor((step + 0.5f) / DAY_STEPS);
+  pixels.resize(height);
+  for (int y = 0; y < height; y++) {
+    float t = static_cast<float>(y) / height * HORIZON_MIX;
+    Uint32 r = static_cast<Uint32>(top.r + (HORIZON_TINT.r - top.r) * t);
+    Uint32 g = static_cast<Uint32>(top.g + (HORIZON_TINT.g - top.g) * t);
+    Uint32 b = static_cast<Uint32>(top.b + (HORIZON_TINT.b - top.b) * t);
+    pixels[y] = 0xFF000000u | (r << 16) | (g << 8) | b;
+  }
+  if (SDL_UpdateTexture(texture, nullptr, pixels.data(), sizeof(Uint32)) !=
+      0) {
+    release();
+    return false;
+  }
+  cachedStep = step;
+  return true;
+}
+
+void SkyLayer::drawSky(SDL_Renderer *renderer, float dayTime, int width,
+                       int height) {
+  if (height <= 0)
+    return;
+
+  int step = static_cast<int>(dayTime * DAY_STEPS);
+  if (step >= DAY_STEPS)
+    step = DAY_STEPS - 1;
+  if (step < 0)
+    step = 0;
+
+  SDL_Rect dst = {0, 0, width, height};
+  if (updateTexture(renderer, step, height)) {
+    SDL_RenderCopy(renderer, texture, nullptr, &dst);
+  } else {
+    // No texture: flat sky
+    SDL_Color top = skyColor(dayTime);
+    SDL_SetRenderDrawColor(renderer, top.r, top.g, top.b, 255);
+    SDL_RenderFillRect(renderer, &dst);
+  }
+}
+
+void SkyLayer::buildStars(int width) {
+  stars.resize(STAR_COUNT);
+  for (int i = 0; i < STAR_COUNT; i++) {
+    stars[i].x = (i * 137 + 50) % width;
+    stars[i].y = (i * 239 + 30) % 300;
+    stars[i].size = 1 + (i % 3);
+    stars[i].phase = static_cast<float>(fmod(2.0 * i, 2.0 * PI));
+  }
+  starWidth = width;
+}
+
+void SkyLayer::drawCelestial(RenderBatch &batch, float dayTime, Uint32 timeMs,
+                             int width) {
+  // Calculate sun/moon position (moves in an arc across the sky)
+  float celestialAngle = dayTime * TWO_PI; // Full circle
+  int celestialX =
+      width / 2 + static_cast<int>(cos(celestialAngle - PI / 2.0f) * width *
+                                   0.4f);
+  int celestialY = 100 + static_cast<int>(sin(celestialAngle - PI / 2.0f) * 150);
+
+  // Draw sun during day (0.2 to 0.8)
+  if (dayTime > 0.2f && dayTime < 0.8f) {
+    // Sun glow
+    batch.setColor(255, 255, 150, 100);
+    for (int i = 0; i < 3; i++) {
+      SDL_Rect glow = {celestialX - 40 - i * 8, celestialY - 40 - i * 8,
+                       80 + i * 16, 80 + i * 16};
+      batch.fillRect(glow);
+    }
+
+    // Sun body
+    batch.setColor(255, 255, 0, 255);
+    SDL_Rect sun = {celestialX - 25, celestialY - 25, 50, 50};
+    batch.fillRect(sun);
+
+    // Sun inner circle
+    batch.setColor(255, 255, 150, 255);
+    SDL_Rect sunInner = {celestialX - 15, celestialY - 15, 30, 30};
+    batch.fillRect(sunInner);
+
+    // Sun rays
+    batch.setColor(255, 255, 100, 255);
+    const SunRay *rays = sunRays();
+    for (int i = 0; i < 8; i++) {
+      int rayX = celestialX + rays[i].x0;
+      int rayY = celestialY + rays[i].y0;
+      int rayEndX = celestialX + rays[i].x1;
+      int rayEndY = celestialY + rays[i].y1;
+      batch.drawLine(rayX, rayY, rayEndX, rayEndY);
+      batch.drawLine(rayX + 1, rayY, rayEndX + 1, rayEndY);
+      batch.drawLine(rayX, rayY + 1, rayEndX, rayEndY + 1);
+    }
+  }
+
+  // Draw moon during night (0.0 to 0.2 and 0.8 to 1.0)
+  if (dayTime < 0.2f || dayTime > 0.8f) {
+    // Moon glow
+    batch.setColor(200, 200, 255, 80);
+    SDL_Rect moonGlow = {celestialX - 35, celestialY - 35, 70, 70};
+    batch.fillRect(moonGlow);
+
+    // Moon body
+    batch.setColor(220, 220, 240, 255);
+    SDL_Rect moon = {celestialX - 20, celestialY - 20, 40, 40};
+    batch.fillRect(moon);
+
+    // Moon craters
+    batch.setColor(180, 180, 200, 255);
+    SDL_Rect crater1 = {celestialX - 8, celestialY - 10, 8, 8};
+    SDL_Rect crater2 = {celestialX + 5, celestialY - 5, 6, 6};
+    SDL_Rect crater3 = {celestialX - 5, celestialY + 5, 7, 7};
+    batch.fillRect(crater1);
+    batch.fillRect(crater2);
+    batch.fillRect(crater3);
+  }
+
+  // Stars during night (more visible at night)
+  if (dayTime < 0.3f || dayTime > 0.7f) {
+    if (width != starWidth)
+      buildStars(width);
+
+    batch.setColor(255, 255, 255,
+                   static_cast<Uint8>(255 * starAlpha(dayTime)));
+
+    // A star shows while sin(2 * seconds + phase) > 0, i.e. while the
+    // angle, wrapped to [0, 2pi), is below pi. One fmod per frame instead
+    // of one sin per star.
+    float angle = static_cast<float>(fmod(timeMs / 1000.0 * 2.0, 2.0 * PI));
+    for (const Star &star : stars) {
+      float starAngle = angle + star.phase;
+      if (starAngle >= TWO_PI)
+        starAngle -= TWO_PI;
+      if (starAngle > 0.0f && starAngle < PI) {
+        SDL_Rect rect = {star.x, star.y, star.size, star.size};
+        batch.fillRect(rect);
+      }
+    }
+  }
+}
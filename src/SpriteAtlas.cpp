@@ -0,0 +1,445 @@
+#include "SpriteAtlas.h"
+#include "GameWorld.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+
+static const int PADDING = 2; // Transparent gap between cells
+
+static void drawPlayer(RenderBatch &batch, int frame, int x, int y) {
+  // Red shirt/body with shading
+  batch.setColor(255, 0, 0, 255);
+  SDL_Rect body = {x + 4, y + 8, 24, 16};
+  batch.fillRect(body);
+
+  // Shirt highlight
+  batch.setColor(255, 100, 100, 255);
+  SDL_Rect bodyHighlight = {x + 6, y + 10, 20, 4};
+  batch.fillRect(bodyHighlight);
+
+  // Buttons on shirt
+  batch.setColor(255, 255, 255, 255);
+  SDL_Rect button1 = {x + 14, y + 14, 2, 2};
+  SDL_Rect button2 = {x + 14, y + 19, 2, 2};
+  batch.fillRect(button1);
+  batch.fillRect(button2);
+
+  // Skin tone head with shading
+  batch.setColor(255, 200, 150, 255);
+  SDL_Rect head = {x + 8, y, 16, 16};
+  batch.fillRect(head);
+
+  // Face shadow
+  batch.setColor(230, 180, 130, 255);
+  SDL_Rect faceShadow = {x + 8, y + 10, 16, 6};
+  batch.fillRect(faceShadow);
+
+  // Eyes
+  batch.setColor(0, 0, 0, 255);
+  int eyeY = y + 6;
+  if (frame == PLAYER_FRAME_DYING)
+    eyeY += 2; // Eyes lower when dying
+  SDL_Rect eye1 = {x + 10, eyeY, 3, 3};
+  SDL_Rect eye2 = {x + 17, eyeY, 3, 3};
+  batch.fillRect(eye1);
+  batch.fillRect(eye2);
+
+  // Mustache
+  batch.setColor(60, 40, 20, 255);
+  SDL_Rect mustache = {x + 10, y + 10, 12, 3};
+  batch.fillRect(mustache);
+
+  // Red cap with detail
+  batch.setColor(200, 0, 0, 255);
+  SDL_Rect cap = {x + 6, y - 4, 20, 8};
+  batch.fillRect(cap);
+
+  // Cap highlight
+  batch.setColor(255, 50, 50, 255);
+  SDL_Rect capHighlight = {x + 8, y - 2, 16, 3};
+  batch.fillRect(capHighlight);
+
+  // Cap logo "M"
+  batch.setColor(255, 255, 255, 255);
+  SDL_Rect mLogo = {x + 14, y, 4, 4};
+  batch.fillRect(mLogo);
+
+  // Blue overalls/legs with detail
+  batch.setColor(0, 0, 200, 255);
+  if (frame < PLAYER_WALK_FRAMES) {
+    int legOffset = frame - PLAYER_WALK_FRAMES / 2;
+    SDL_Rect leg1 = {x + 8 + legOffset, y + 24, 6, 8};
+    SDL_Rect leg2 = {x + 18 - legOffset, y + 24, 6, 8};
+    batch.fillRect(leg1);
+    batch.fillRect(leg2);
+
+    // Shoe highlights
+    batch.setColor(100, 50, 0, 255);
+    SDL_Rect shoe1 = {x + 7 + legOffset, y + 29, 8, 3};
+    SDL_Rect shoe2 = {x + 17 - legOffset, y + 29, 8, 3};
+    batch.fillRect(shoe1);
+    batch.fillRect(shoe2);
+  } else {
+    SDL_Rect leg = {x + 10, y + 24, 12, 8};
+    batch.fillRect(leg);
+
+    // Shoe
+    batch.setColor(100, 50, 0, 255);
+    SDL_Rect shoe = {x + 9, y + 29, 14, 3};
+    batch.fillRect(shoe);
+  }
+}
+
+static void drawEnemy(RenderBatch &batch, int frame, int x, int y) {
+  SDL_Rect rect = {x, y, ENEMY_SIZE, ENEMY_SIZE};
+
+  // Body - brown mushroom/goomba style with texture
+  batch.setColor(139, 69, 19, 255);
+  batch.fillRect(rect);
+
+  // Add texture lines to body
+  batch.setColor(115, 55, 15, 255);
+  for (int i = 0; i < 3; i++) {
+    SDL_Rect line = {x + 4 + i * 7, y + 4, 3, rect.h - 8};
+    batch.fillRect(line);
+  }
+
+  // Top cap highlight
+  batch.setColor(160, 82, 45, 255);
+  SDL_Rect capHighlight = {x + 2, y + 2, rect.w - 4, 6};
+  batch.fillRect(capHighlight);
+
+  // Eyes with white sclera
+  batch.setColor(255, 255, 255, 255);
+  SDL_Rect eye1 = {x + 5, y + 10, 7, 7};
+  SDL_Rect eye2 = {x + 16, y + 10, 7, 7};
+  batch.fillRect(eye1);
+  batch.fillRect(eye2);
+
+  // Pupils - looking in direction of movement (frame 1: right)
+  batch.setColor(0, 0, 0, 255);
+  int pupilOffset = frame == 1 ? 2 : 0;
+  SDL_Rect pupil1 = {x + 7 + pupilOffset, y + 12, 3, 4};
+  SDL_Rect pupil2 = {x + 18 + pupilOffset, y + 12, 3, 4};
+  batch.fillRect(pupil1);
+  batch.fillRect(pupil2);
+
+  // Angry eyebrows
+  SDL_Rect brow1 = {x + 4, y + 8, 8, 2};
+  SDL_Rect brow2 = {x + 16, y + 8, 8, 2};
+  batch.fillRect(brow1);
+  batch.fillRect(brow2);
+
+  // Frown mouth
+  SDL_Rect mouth = {x + 10, y + 20, 8, 2};
+  batch.fillRect(mouth);
+
+  // Body outline
+  batch.drawRect(rect);
+}
+
+// (x, y) is the coin's center; the frame is its width while spinning
+static void drawCoin(RenderBatch &batch, int frame, int x, int y) {
+  int width = frame + 4;
+
+  // Gold coin with shine effect
+  batch.setColor(255, 215, 0, 255);
+  SDL_Rect coinRect = {x - width / 2, y - 8, width, 16};
+  batch.fillRect(coinRect);
+
+  // Inner darker gold
+  batch.setColor(218, 165, 32, 255);
+  SDL_Rect innerCoin = {x - width / 2 + 2, y - 6, width > 4 ? width - 4 : 2,
+                        12};
+  batch.fillRect(innerCoin);
+
+  // Shine highlight
+  if (width > 6) {
+    batch.setColor(255, 250, 205, 255);
+    SDL_Rect shine = {x - width / 2 + 2, y - 6, width / 3, 4};
+    batch.fillRect(shine);
+  }
+
+  // Border
+  batch.setColor(184, 134, 11, 255);
+  batch.drawRect(coinRect);
+}
+
+static void drawItem(RenderBatch &batch, SpriteId id, int x, int y) {
+  switch (id) {
+  case SpriteId::SWORD: {
+    // Draw sword (gray blade, brown handle)
+    batch.setColor(192, 192, 192, 255);
+    SDL_Rect blade = {x + 8, y, 16, 24};
+    batch.fillRect(blade);
+    batch.setColor(139, 69, 19, 255);
+    SDL_Rect handle = {x + 10, y + 20, 12, 10};
+    batch.fillRect(handle);
+    break;
+  }
+
+  case SpriteId::POISON_MUSHROOM: {
+    // Draw purple mushroom with skull
+    batch.setColor(128, 0, 128, 255);
+    SDL_Rect poisonCap = {x + 4, y, 24, 16};
+    batch.fillRect(poisonCap);
+    batch.setColor(200, 200, 200, 255);
+    SDL_Rect poisonStem = {x + 10, y + 14, 12, 18};
+    batch.fillRect(poisonStem);
+    // Skull dots
+    batch.setColor(0, 0, 0, 255);
+    SDL_Rect eye1 = {x + 10, y + 6, 4, 4};
+    SDL_Rect eye2 = {x + 18, y + 6, 4, 4};
+    batch.fillRect(eye1);
+    batch.fillRect(eye2);
+    break;
+  }
+
+  case SpriteId::POWER_MUSHROOM: {
+    // Draw red mushroom with white dots
+    batch.setColor(255, 0, 0, 255);
+    SDL_Rect powerCap = {x + 4, y, 24, 16};
+    batch.fillRect(powerCap);
+    batch.setColor(255, 255, 255, 255);
+    SDL_Rect dot1 = {x + 8, y + 4, 4, 4};
+    SDL_Rect dot2 = {x + 20, y + 4, 4, 4};
+    batch.fillRect(dot1);
+    batch.fillRect(dot2);
+    batch.setColor(240, 200, 150, 255);
+    SDL_Rect powerStem = {x + 10, y + 14, 12, 18};
+    batch.fillRect(powerStem);
+    break;
+  }
+
+  case SpriteId::EXTRA_LIFE: {
+    // Draw green heart
+    batch.setColor(0, 255, 0, 255);
+    SDL_Rect heart = {x + 6, y + 6, 20, 20};
+    batch.fillRect(heart);
+    batch.setColor(0, 200, 0, 255);
+    SDL_Rect heartInner = {x + 10, y + 10, 12, 12};
+    batch.fillRect(heartInner);
+    break;
+  }
+
+  default:
+    return;
+  }
+
+  // Item border
+  batch.setColor(0, 0, 0, 255);
+  SDL_Rect border = {x, y, 32, 32};
+  batch.drawRect(border);
+}
+
+void SpriteAtlas::drawSprite(RenderBatch &batch, SpriteId id, int frame,
+                             int x, int y) {
+  switch (id) {
+  case SpriteId::PLAYER:
+    drawPlayer(batch, frame, x, y);
+    break;
+  case SpriteId::ENEMY:
+    drawEnemy(batch, frame, x, y);
+    break;
+  case SpriteId::COIN:
+    drawCoin(batch, frame, x, y);
+    break;
+  default:
+    drawItem(batch, id, x, y);
+    break;
+  }
+}
+
+int SpriteAtlas::frameCount(SpriteId id) {
+  switch (id) {
+  case SpriteId::PLAYER:
+    return PLAYER_WALK_FRAMES + 2;
+  case SpriteId::ENEMY:
+    return 2;
+  case SpriteId::COIN:
+    return 13; // Widths 4 .. 16
+  default:
+    return 1;
+  }
+}
+
+int SpriteAtlas::playerFrame(bool onGround, bool dying, float animPhase) {
+  if (dying)
+    return PLAYER_FRAME_DYING;
+  if (!onGround)
+    return PLAYER_FRAME_AIR;
+  int legOffset = static_cast<int>(std::sin(animPhase) * 3);
+  return legOffset + PLAYER_WALK_FRAMES / 2;
+}
+
+int SpriteAtlas::enemyFrame(float vx) { return vx > 0 ? 1 : 0; }
+
+int SpriteAtlas::coinFrame(float animPhase) {
+  int width = static_cast<int>(16 * std::abs(std::cos(animPhase)));
+  return width < 4 ? 0 : width - 4;
+}
+
+SpriteId SpriteAtlas::itemSprite(ItemType type) {
+  switch (type) {
+  case ItemType::SWORD:
+    return SpriteId::SWORD;
+  case ItemType::POISON_MUSHROOM:
+    return SpriteId::POISON_MUSHROOM;
+  case ItemType::POWER_MUSHROOM:
+    return SpriteId::POWER_MUSHROOM;
+  default:
+    return SpriteId::EXTRA_LIFE;
+  }
+}
+
+SpriteAtlas::SpriteAtlas() : texture(nullptr) {
+  // One row per sprite, its frames side by side. Everything takes about
+  // 304 x 222 of the ATLAS_WIDTH x ATLAS_HEIGHT texture.
+  int rowY = 0;
+  for (int i = 0; i < static_cast<int>(SpriteId::COUNT); i++) {
+    SpriteId id = static_cast<SpriteId>(i);
+    firstFrame[i] = static_cast<int>(frames.size());
+
+    int x = 0;
+    int rowHeight = 0;
+    for (int f = 0; f < frameCount(id); f++) {
+      Frame frame;
+      switch (id) {
+      case SpriteId::PLAYER: // The cap sticks out 4px above the box
+        frame.src = {x, rowY, PLAYER_SIZE, PLAYER_SIZE + 4};
+        frame.offsetX = 0;
+        frame.offsetY = -4;
+        break;
+      case SpriteId::ENEMY:
+        frame.src = {x, rowY, ENEMY_SIZE, ENEMY_SIZE};
+        frame.offsetX = 0;
+        frame.offsetY = 0;
+        break;
+      case SpriteId::COIN:
+        frame.src = {x, rowY, f + 4, COIN_SIZE};
+        frame.offsetX = -((f + 4) / 2);
+        frame.offsetY = -COIN_SIZE / 2;
+        break;
+      default:
+        frame.src = {x, rowY, 32, 32};
+        frame.offsetX = 0;
+        frame.offsetY = 0;
+        break;
+      }
+      frames.push_back(frame);
+      x += frame.src.w + PADDING;
+      rowHeight = std::max(rowHeight, frame.src.h);
+    }
+    rowY += rowHeight + PADDING;
+  }
+}
+
+SpriteAtlas::~SpriteAtlas() { release(); }
+
+void SpriteAtlas::release() {
+  if (texture) {
+    SDL_DestroyTexture(texture);
+    texture = nullptr;
+  }
+  pending.clear();
+}
+
+const SpriteAtlas::Frame &SpriteAtlas::frameOf(SpriteId id, int frame) const {
+  return frames[firstFrame[static_cast<int>(id)] + frame];
+}
+
+bool SpriteAtlas::bake(SDL_Renderer *renderer) {
+  release();
+
+  SDL_Texture *atlas =
+      SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                        SDL_TEXTUREACCESS_TARGET, ATLAS_WIDTH, ATLAS_HEIGHT);
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  if (!atlas || SDL_SetRenderTarget(renderer, atlas) != 0) {
+    if (atlas)
+      SDL_DestroyTexture(atlas);
+    LOG_WARN("Sprite atlas unavailable, drawing sprites directly: %s",
+             SDL_GetError());
+    return false;
+  }
+
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+  SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  RenderBatch bakeBatch(renderer);
+  for (int i = 0; i < static_cast<int>(SpriteId::COUNT); i++) {
+    SpriteId id = static_cast<SpriteId>(i);
+    for (int f = 0; f < frameCount(id); f++) {
+      const Frame &frame = frameOf(id, f);
+      drawSprite(bakeBatch, id, f, frame.src.x - frame.offsetX,
+                 frame.src.y - frame.offsetY);
+    }
+  }
+  bakeBatch.flush();
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+  texture = atlas;
+  return true;
+}
+
+void SpriteAtlas::draw(RenderBatch &batch, SpriteId id, int frame, int x,
+                       int y) {
+  if (!texture) {
+    drawSprite(batch, id, frame, x, y);
+    return;
+  }
+
+  const Frame &f = frameOf(id, frame);
+  Quad quad = {f.src, {x + f.offsetX, y + f.offsetY, f.src.w, f.src.h}};
+  pending.push_back(quad);
+}
+
+void SpriteAtlas::flush(RenderBatch &batch) {
+  if (pending.empty())
+    return;
+
+  batch.flush();
+  SDL_Renderer *renderer = batch.getRenderer();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  vertices.clear();
+  indices.clear();
+
+  const SDL_Color white = {255, 255, 255, 255};
+  const float su = 1.0f / ATLAS_WIDTH;
+  const float sv = 1.0f / ATLAS_HEIGHT;
+  for (const Quad &q : pending) {
+    float x0 = static_cast<float>(q.dst.x);
+    float y0 = static_cast<float>(q.dst.y);
+    float x1 = x0 + q.dst.w;
+    float y1 = y0 + q.dst.h;
+    float u0 = q.src.x * su, v0 = q.src.y * sv;
+    float u1 = (q.src.x + q.src.w) * su, v1 = (q.src.y + q.src.h) * sv;
+
+    int base = static_cast<int>(vertices.size());
+    SDL_Vertex quad[4] = {{{x0, y0}, white, {u0, v0}},
+                          {{x1, y0}, white, {u1, v0}},
+                          {{x1, y1}, white, {u1, v1}},
+                          {{x0, y1}, white, {u0, v1}}};
+    vertices.insert(vertices.end(), quad, quad + 4);
+
+    int quadIndices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    indices.insert(indices.end(), quadIndices, quadIndices + 6);
+  }
+
+  SDL_RenderGeometry(renderer, texture, vertices.data(),
+                     static_cast<int>(vertices.size()), indices.data(),
+                     static_cast<int>(indices.size()));
+#else
+  for (const Quad &q : pending) {
+    SDL_RenderCopy(renderer, texture, &q.src, &q.dst);
+  }
+#endif
+
+  pending.clear();
+}
@@ -0,0 +1,89 @@
+#include "SweptCollision.h"
+#include <algorithm>
+#include <limits>
+
+// Entry and exit times of an interval [start, start + size) moving by
+// delta through [solidStart, solidStart + solidSize). With no motion the
+// times are infinite when the intervals overlap, and empty otherwise.
+static bool axisTimes(float start, float size, float delta, float solidStart,
+                      float solidSize, float &entry, float &exit) {
+  const float inf = std::numeric_limits<float>::infinity();
+  if (delta > 0.0f) {
+    entry = (solidStart - (start + size)) / delta;
+    exit = (solidStart + solidSize - start) / delta;
+  } else if (delta < 0.0f) {
+    entry = (solidStart + solidSize - start) / delta;
+    exit = (solidStart - (start + size)) / delta;
+  } else {
+    if (start + size <= solidStart || start >= solidStart + solidSize)
+      return false;
+    entry = -inf;
+    exit = inf;
+  }
+  return true;
+}
+
+bool sweepAABB(const AABB &box, float dx, float dy, const AABB &solid,
+               SweepHit &hit) {
+  if (dx == 0.0f && dy == 0.0f)
+    return false;
+
+  float entryX, exitX, entryY, exitY;
+  if (!axisTimes(box.x, box.w, dx, solid.x, solid.w, entryX, exitX) ||
+      !axisTimes(box.y, box.h, dy, solid.y, solid.h, entryY, exitY))
+    return false;
+
+  float entry = std::max(entryX, entryY);
+  float exit = std::min(exitX, exitY);
+
+  // Separated for the whole move, contact after it, or already inside.
+  // exit == entry is a corner graze, which doesn't count either.
+  if (entry >= exit || entry >= 1.0f || entry < 0.0f)
+    return false;
+
+  hit.time = entry;
+  if (entryX > entryY) {
+    hit.normalX = dx > 0.0f ? -1.0f : 1.0f;
+    hit.normalY = 0.0f;
+  } else {
+    hit.normalX = 0.0f;
+    hit.normalY = dy > 0.0f ? -1.0f : 1.0f;
+  }
+  return true;
+}
+
+AxisSweep sweepAxis(const AABB &box, SweepAxis axis, float delta,
+                    const std::vector<Platform *> &platforms) {
+  const bool horizontal = axis == SweepAxis::X;
+  AxisSweep result;
+  result.position = (horizontal ? box.x : box.y) + delta;
+  result.platform = nullptr;
+  if (delta == 0.0f)
+    return result;
+
+  float dx = horizontal ? delta : 0.0f;
+  float dy = horizontal ? 0.0f : delta;
+  float firstTime = 1.0f;
+  for (Platform *platform : platforms) {
+    const SDL_Rect &r = platform->rect;
+    AABB solid = {static_cast<float>(r.x), static_cast<float>(r.y),
+                  static_cast<float>(r.w), static_cast<float>(r.h)};
+    SweepHit hit;
+    if (sweepAABB(box, dx, dy, solid, hit) && hit.time < firstTime) {
+      firstTime = hit.time;
+      result.platform = platform;
+    }
+  }
+
+  // Snap flush to the face that was hit; start + delta * time could land
+  // a rounding error inside it
+  if (result.platform) {
+    const SDL_Rect &r = result.platform->rect;
+    if (horizontal) {
+      result.position = delta > 0.0f ? r.x - box.w : r.x + r.w;
+    } else {
+      result.position = delta > 0.0f ? r.y - box.h : r.y + r.h;
+    }
+  }
+  return result;
+}
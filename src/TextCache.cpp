@@ -0,0 +1,230 @@
+#include "TextCache.h"
+#include <algorithm>
+#include <iostream>
+
+TextCache &TextCache::instance() {
+  // Intentionally leaked: atlas textures belong to the renderer and must be
+  // released through clear() while it is still alive, not at static exit.
+  static TextCache *cache = new TextCache();
+  return *cache;
+}
+
+int TextCache::glyphIndex(char c) {
+  int code = static_cast<unsigned char>(c);
+  if (code < FIRST_GLYPH || code > LAST_GLYPH)
+    code = '?';
+  return code - FIRST_GLYPH;
+}
+
+bool TextCache::buildAtlas(SDL_Renderer *renderer, TTF_Font *font,
+                           GlyphAtlas &atlas) {
+  atlas.renderer = renderer;
+  atlas.texture = nullptr;
+  atlas.width = 0;
+  atlas.height = 0;
+  atlas.lineHeight = TTF_FontHeight(font);
+
+  // Rasterize every printable ASCII glyph once, in white, so any color
+  // can be applied later through vertex color modulation
+  SDL_Color white = {255, 255, 255, 255};
+  SDL_Surface *glyphSurfaces[GLYPH_COUNT];
+  int cellW = 1;
+  int cellH = std::max(1, atlas.lineHeight);
+
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    char str[2] = {static_cast<char>(FIRST_GLYPH + i), '\0'};
+    glyphSurfaces[i] = TTF_RenderText_Solid(font, str, white);
+
+    int advance = 0;
+    if (TTF_GlyphMetrics(font, static_cast<Uint16>(FIRST_GLYPH + i), nullptr,
+                         nullptr, nullptr, nullptr, &advance) != 0) {
+      advance = glyphSurfaces[i] ? glyphSurfaces[i]->w : 0;
+    }
+    atlas.advance[i] = advance;
+
+    if (glyphSurfaces[i]) {
+      cellW = std::max(cellW, glyphSurfaces[i]->w);
+      cellH = std::max(cellH, glyphSurfaces[i]->h);
+    }
+  }
+
+  int atlasRows = (GLYPH_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+  atlas.width = cellW * ATLAS_COLUMNS;
+  atlas.height = cellH * atlasRows;
+
+  SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(
+      0, atlas.width, atlas.height, 32, SDL_PIXELFORMAT_RGBA32);
+  if (sheet) {
+    SDL_FillRect(sheet, nullptr, SDL_MapRGBA(sheet->format, 0, 0, 0, 0));
+  }
+
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    SDL_Rect &glyph = atlas.glyphs[i];
+    glyph.x = (i % ATLAS_COLUMNS) * cellW;
+    glyph.y = (i / ATLAS_COLUMNS) * cellH;
+    glyph.w = 0;
+    glyph.h = 0;
+
+    if (glyphSurfaces[i]) {
+      if (sheet) {
+        glyph.w = glyphSurfaces[i]->w;
+        glyph.h = glyphSurfaces[i]->h;
+        SDL_Rect dst = glyph;
+        SDL_BlitSurface(glyphSurfaces[i], nullptr, sheet, &dst);
+      }
+      SDL_FreeSurface(glyphSurfaces[i]);
+    }
+  }
+
+  if (!sheet) {
+    std::cerr << "TextCache: failed to create glyph sheet: " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+
+  atlas.texture = SDL_CreateTextureFromSurface(renderer, sheet);
+  SDL_FreeSurface(sheet);
+
+  if (!atlas.texture) {
+    std::cerr << "TextCache: failed to upload glyph atlas: " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+TextCache::GlyphAtlas *TextCache::getAtlas(SDL_Renderer *renderer,
+                                           TTF_Font *font) {
+  std::map<TTF_Font *, GlyphAtlas>::iterator it = atlases.find(font);
+  if (it != atlases.end()) {
+    if (it->second.renderer == renderer)
+      return it->second.texture ? &it->second : nullptr;
+
+    // Same font drawn through another renderer: rebuild for that one
+    if (it->second.texture)
+      SDL_DestroyTexture(it->second.texture);
+    atlases.erase(it);
+  }
+
+  // A failed build is still stored (without texture) so it is not retried
+  // every frame
+  GlyphAtlas &atlas = atlases[font];
+  buildAtlas(renderer, font, atlas);
+  return atlas.texture ? &atlas : nullptr;
+}
+
+void TextCache::measureText(SDL_Renderer *renderer, TTF_Font *font,
+                            const char *text, int *w, int *h) {
+  int width = 0;
+  int height = 0;
+
+  GlyphAtlas *atlas = (font && text) ? getAtlas(renderer, font) : nullptr;
+  if (atlas) {
+    for (const char *c = text; *c; c++) {
+      width += atlas->advance[glyphIndex(*c)];
+    }
+    height = atlas->lineHeight;
+  }
+
+  if (w)
+    *w = width;
+  if (h)
+    *h = height;
+}
+
+void TextCache::renderText(SDL_Renderer *renderer, TTF_Font *font,
+                           const char *text, int x, int y, SDL_Color color,
+                           bool centered) {
+  if (!font || !text || !*text)
+    return;
+
+  GlyphAtlas *atlas = getAtlas(renderer, font);
+  if (!atlas)
+    return;
+
+  int penX = x;
+  if (centered) {
+    int width = 0;
+    measureText(renderer, font, text, &width, nullptr);
+    penX = x - width / 2;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  // Whole string goes out as a single geometry batch
+  vertices.clear();
+  indices.clear();
+
+  float invW = 1.0f / atlas->width;
+  float invH = 1.0f / atlas->height;
+
+  for (const char *c = text; *c; c++) {
+    int index = glyphIndex(*c);
+    const SDL_Rect &glyph = atlas->glyphs[index];
+
+    if (*c != ' ' && glyph.w > 0 && glyph.h > 0) {
+      float x0 = static_cast<float>(penX);
+      float y0 = static_cast<float>(y);
+      float x1 = x0 + glyph.w;
+      float y1 = y0 + glyph.h;
+      float u0 = glyph.x * invW;
+      float v0 = glyph.y * invH;
+      float u1 = (glyph.x + glyph.w) * invW;
+      float v1 = (glyph.y + glyph.h) * invH;
+
+      int base = static_cast<int>(vertices.size());
+      SDL_Vertex quad[4] = {{{x0, y0}, color, {u0, v0}},
+                            {{x1, y0}, color, {u1, v0}},
+                            {{x1, y1}, color, {u1, v1}},
+                            {{x0, y1}, color, {u0, v1}}};
+      vertices.insert(vertices.end(), quad, quad + 4);
+
+      int quadIndices[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+      indices.insert(indices.end(), quadIndices, quadIndices + 6);
+    }
+
+    penX += atlas->advance[index];
+  }
+
+  if (!vertices.empty()) {
+    SDL_RenderGeometry(renderer, atlas->texture, vertices.data(),
+                       static_cast<int>(vertices.size()), indices.data(),
+                       static_cast<int>(indices.size()));
+  }
+#else
+  // Older SDL: one copy per glyph, still no rasterization or upload
+  SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+  SDL_SetTextureAlphaMod(atlas->texture, color.a);
+
+  for (const char *c = text; *c; c++) {
+    int index = glyphIndex(*c);
+    const SDL_Rect &glyph = atlas->glyphs[index];
+
+    if (*c != ' ' && glyph.w > 0 && glyph.h > 0) {
+      SDL_Rect dst = {penX, y, glyph.w, glyph.h};
+      SDL_RenderCopy(renderer, atlas->texture, &glyph, &dst);
+    }
+
+    penX += atlas->advance[index];
+  }
+#endif
+}
+
+void TextCache::releaseFont(TTF_Font *font) {
+  std::map<TTF_Font *, GlyphAtlas>::iterator it = atlases.find(font);
+  if (it == atlases.end())
+    return;
+
+  if (it->second.texture)
+    SDL_DestroyTexture(it->second.texture);
+  atlases.erase(it);
+}
+
+void TextCache::clear() {
+  for (auto &entry : atlases) {
+    if (entry.second.texture)
+      SDL_DestroyTexture(entry.second.texture);
+  }
+  atlases.clear();
+}
@@ -0,0 +1,107 @@
+#include "TileGrid.h"
+#include <algorithm>
+
+TileGrid::TileGrid() : originX(0), cellSize(32), columns(0), rows(0) {}
+
+void TileGrid::clear() {
+  columns = 0;
+  rows = 0;
+  cellStart.clear();
+  entries.clear();
+}
+
+void TileGrid::build(const std::vector<Platform> &platforms, int size,
+                     int origin) {
+  clear();
+  cellSize = size > 0 ? size : 32;
+  originX = origin;
+
+  // Grid covers everything from (originX, 0) to the far corner of the last
+  // platform. Platforms left of originX are clamped into column 0.
+  int maxRight = 0;
+  int maxBottom = 0;
+  for (const auto &platform : platforms) {
+    maxRight =
+        std::max(maxRight, platform.rect.x + platform.rect.w - originX);
+    maxBottom = std::max(maxBottom, platform.rect.y + platform.rect.h);
+  }
+  columns = (maxRight + cellSize - 1) / cellSize;
+  rows = (maxBottom + cellSize - 1) / cellSize;
+  if (columns <= 0 || rows <= 0) {
+    clear();
+    return;
+  }
+
+  // Pass 1: count platforms per cell
+  cellStart.assign(columns * rows + 1, 0);
+  for (const auto &platform : platforms) {
+    const SDL_Rect &r = platform.rect;
+    int c0 = std::max(0, (r.x - originX) / cellSize);
+    int c1 = std::min(columns - 1, (r.x - originX + r.w - 1) / cellSize);
+    int r0 = std::max(0, r.y / cellSize);
+    int r1 = std::min(rows - 1, (r.y + r.h - 1) / cellSize);
+    for (int row = r0; row <= r1; row++) {
+      for (int col = c0; col <= c1; col++) {
+        cellStart[row * columns + col + 1]++;
+      }
+    }
+  }
+
+  // Prefix sum turns counts into start offsets
+  for (size_t i = 1; i < cellStart.size(); i++) {
+    cellStart[i] += cellStart[i - 1];
+  }
+
+  // Pass 2: fill indices
+  entries.resize(cellStart.back());
+  std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+  for (size_t i = 0; i < platforms.size(); i++) {
+    const SDL_Rect &r = platforms[i].rect;
+    int c0 = std::max(0, (r.x - originX) / cellSize);
+    int c1 = std::min(columns - 1, (r.x - originX + r.w - 1) / cellSize);
+    int r0 = std::max(0, r.y / cellSize);
+    int r1 = std::min(rows - 1, (r.y + r.h - 1) / cellSize);
+    for (int row = r0; row <= r1; row++) {
+      for (int col = c0; col <= c1; col++) {
+        entries[cursor[row * columns + col]++] = static_cast<int>(i);
+      }
+    }
+  }
+}
+
+void TileGrid::query(const SDL_Rect &area, std::vector<int> &out) const {
+  if (columns == 0 || rows == 0 || area.w <= 0 || area.h <= 0)
+    return;
+
+  int left = area.x - originX;
+  int right = left + area.w - 1;
+  int bottom = area.y + area.h - 1;
+  if (right < 0 || bottom < 0)
+    return;
+
+  // Areas partly left of / above the grid clamp to the first cell
+  int c0 = left >= 0 ? left / cellSize : 0;
+  int r0 = area.y >= 0 ? area.y / cellSize : 0;
+  int c1 = right / cellSize;
+  int r1 = bottom / cellSize;
+
+  c0 = std::max(c0, 0);
+  r0 = std::max(r0, 0);
+  c1 = std::min(c1, columns - 1);
+  r1 = std::min(r1, rows - 1);
+  if (c0 > c1 || r0 > r1)
+    return;
+
+  size_t first = out.size();
+  for (int row = r0; row <= r1; row++) {
+    for (int col = c0; col <= c1; col++) {
+      int cell = row * columns + col;
+      out.insert(out.end(), entries.begin() + cellStart[cell],
+                 entries.begin() + cellStart[cell + 1]);
+    }
+  }
+
+  // Tall platforms (the ground strip) span several cells
+  std::sort(out.begin() + first, out.end());
+  out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
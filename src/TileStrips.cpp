@@ -0,0 +1,158 @@
+#include "TileStrips.h"
+#include "Log.h"
+#include <cmath>
+
+TileStrips::TileStrips() : frame(0), failed(false) {}
+
+TileStrips::~TileStrips() { release(); }
+
+void TileStrips::release() {
+  for (Strip &strip : strips) {
+    if (strip.texture)
+      SDL_DestroyTexture(strip.texture);
+  }
+  strips.clear();
+}
+
+TileKind TileStrips::kindOf(const Platform &platform, int groundY) {
+  if (platform.isBreakable)
+    return platform.isHit ? TileKind::USED : TileKind::QUESTION;
+  return platform.rect.y >= groundY - 5 ? TileKind::GROUND : TileKind::BRICK;
+}
+
+int TileStrips::questionBounce(Uint32 currentTime) {
+  return static_cast<int>(std::sin(currentTime * 0.005f) * 2);
+}
+
+bool TileStrips::render(SDL_Renderer *renderer, TileTextures &tiles,
+                        const LevelChunk &chunk, int viewHeight,
+                        Strip &strip) {
+  // Reuse the evicted texture when the size fits; only the level's last
+  // chunk can be narrower
+  if (strip.texture) {
+    int w = 0, h = 0;
+    SDL_QueryTexture(strip.texture, nullptr, nullptr, &w, &h);
+    if (w != chunk.width || h != viewHeight) {
+      SDL_DestroyTexture(strip.texture);
+      strip.texture = nullptr;
+    }
+  }
+  if (!strip.texture) {
+    strip.texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                          SDL_TEXTUREACCESS_TARGET, chunk.width, viewHeight);
+    if (!strip.texture)
+      return false;
+    SDL_SetTextureBlendMode(strip.texture, SDL_BLENDMODE_BLEND);
+  }
+
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+  if (SDL_SetRenderTarget(renderer, strip.texture) != 0) {
+    SDL_DestroyTexture(strip.texture);
+    strip.texture = nullptr;
+    return false;
+  }
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  int groundY = viewHeight - TileTextures::GROUND_HEIGHT;
+  strip.questionBlocks.clear();
+  for (const Platform &platform : chunk.platforms) {
+    if (!platform.isBreakable && !platform.isBrick)
+      continue;
+
+    TileKind kind = kindOf(platform, groundY);
+    if (kind == TileKind::QUESTION) {
+      strip.questionBlocks.push_back(platform.rect);
+      continue;
+    }
+
+    SDL_Rect local = {platform.rect.x - chunk.startX, platform.rect.y,
+                      platform.rect.w, platform.rect.h};
+    tiles.draw(renderer, kind, local);
+  }
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+  return true;
+}
+
+TileStrips::Strip *TileStrips::acquire(SDL_Renderer *renderer,
+                                       TileTextures &tiles,
+                                       const LevelChunk &chunk,
+                                       unsigned int revision,
+                                       int viewHeight) {
+  // The chunk's strip, or else the least recently used one
+  Strip *victim = &strips[0];
+  for (Strip &strip : strips) {
+    if (strip.chunkIndex == chunk.index) {
+      strip.lastUsed = frame;
+      if (strip.revision == revision)
+        return &strip;
+
+      // A block in this chunk was hit since the strip was drawn
+      victim = &strip;
+      break;
+    }
+    if (strip.lastUsed < victim->lastUsed)
+      victim = &strip;
+  }
+
+  if (!render(renderer, tiles, chunk, viewHeight, *victim)) {
+    victim->chunkIndex = -1;
+    victim->lastUsed = 0;
+    return nullptr;
+  }
+  victim->chunkIndex = chunk.index;
+  victim->revision = revision;
+  victim->lastUsed = frame;
+  return victim;
+}
+
+bool TileStrips::draw(SDL_Renderer *renderer, TileTextures &tiles,
+                      const LevelStreamer &streamer, int originX,
+                      int viewWidth, int viewHeight, Uint32 currentTime) {
+  if (failed)
+    return false;
+  frame++;
+
+  // Room for every strip the view can touch at once, plus spares
+  const int stripWidth = LevelStreamer::CHUNK_COLUMNS * TILE_SIZE;
+  size_t capacity =
+      static_cast<size_t>(viewWidth / stripWidth + 2 + SPARE_STRIPS);
+  if (strips.size() < capacity) {
+    Strip unused = {nullptr, -1, 0, 0, std::vector<SDL_Rect>()};
+    strips.resize(capacity, unused);
+  }
+
+  int bounce = questionBounce(currentTime);
+
+  for (const LevelChunk &chunk : streamer.getResidentChunks()) {
+    if (chunk.startX + chunk.width <= originX ||
+        chunk.startX >= originX + viewWidth)
+      continue;
+
+    Strip *strip = acquire(renderer, tiles, chunk,
+                           streamer.getChunkRevision(chunk.index), viewHeight);
+    if (!strip) {
+      LOG_WARN("Tile strips unavailable, drawing tiles directly: %s",
+               SDL_GetError());
+      release();
+      failed = true;
+      return false;
+    }
+
+    SDL_Rect dst = {chunk.startX - originX, 0, chunk.width, viewHeight};
+    SDL_RenderCopy(renderer, strip->texture, nullptr, &dst);
+
+    for (const SDL_Rect &block : strip->questionBlocks) {
+      SDL_Rect screenRect = {block.x - originX, block.y + bounce, block.w,
+                             block.h};
+      tiles.draw(renderer, TileKind::QUESTION, screenRect);
+    }
+  }
+  return true;
+}
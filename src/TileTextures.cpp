@@ -0,0 +1,257 @@
+#include "TileTextures.h"
+#include "GameBox.h"
+#include <iostream>
+
+static void drawGroundTile(SDL_Renderer *renderer, const SDL_Rect &rect) {
+  // Grass layer with detail
+  SDL_SetRenderDrawColor(renderer, 123, 192, 67, 255);
+  SDL_Rect grass = {rect.x, rect.y, rect.w, 20};
+  SDL_RenderFillRect(renderer, &grass);
+
+  // Grass blades
+  SDL_SetRenderDrawColor(renderer, 100, 170, 50, 255);
+  for (int i = 0; i < rect.w; i += 4) {
+    SDL_Rect blade = {rect.x + i, rect.y, 2, 12 + (i % 8)};
+    SDL_RenderFillRect(renderer, &blade);
+  }
+
+  // Dirt layer with texture
+  SDL_SetRenderDrawColor(renderer, 139, 90, 43, 255);
+  SDL_Rect dirt = {rect.x, rect.y + 20, rect.w, rect.h - 20};
+  SDL_RenderFillRect(renderer, &dirt);
+
+  // Add dirt texture - dots and patterns. The pattern is tile-local, so it
+  // no longer shimmers while the camera scrolls.
+  SDL_SetRenderDrawColor(renderer, 120, 75, 35, 255);
+  for (int y = 0; y < rect.h - 20; y += 6) {
+    for (int x = 0; x < rect.w; x += 8) {
+      int dotSize = ((x + y) % 3) + 1;
+      SDL_Rect dot = {rect.x + x + ((x + y) % 4), rect.y + 20 + y, dotSize,
+                      dotSize};
+      SDL_RenderFillRect(renderer, &dot);
+    }
+  }
+
+  // Lighter dirt spots
+  SDL_SetRenderDrawColor(renderer, 160, 110, 60, 255);
+  for (int y = 0; y < rect.h - 20; y += 8) {
+    for (int x = 0; x < rect.w; x += 12) {
+      if ((x + y) % 5 == 0) {
+        SDL_Rect lightSpot = {rect.x + x, rect.y + 22 + y, 3, 3};
+        SDL_RenderFillRect(renderer, &lightSpot);
+      }
+    }
+  }
+}
+
+static void drawBrickTile(SDL_Renderer *renderer, const SDL_Rect &rect) {
+  // Base brick color
+  SDL_SetRenderDrawColor(renderer, 184, 111, 80, 255);
+  SDL_RenderFillRect(renderer, &rect);
+
+  // Brick pattern - individual bricks
+  int brickW = 16;
+  int brickH = 16;
+
+  for (int by = 0; by < rect.h; by += brickH) {
+    for (int bx = 0; bx < rect.w; bx += brickW) {
+      // Offset every other row
+      int offset = (by / brickH) % 2 == 0 ? 0 : brickW / 2;
+      int actualX = rect.x + bx + offset;
+
+      // Skip if brick would be completely outside
+      if (actualX >= rect.x + rect.w || actualX + brickW <= rect.x)
+        continue;
+
+      // Calculate clipped brick dimensions
+      int brickStartX = actualX;
+      int brickStartY = rect.y + by;
+      int brickEndX = actualX + brickW;
+      int brickEndY = rect.y + by + brickH;
+
+      // Clip to platform bounds
+      if (brickStartX < rect.x)
+        brickStartX = rect.x;
+      if (brickEndX > rect.x + rect.w)
+        brickEndX = rect.x + rect.w;
+      if (brickEndY > rect.y + rect.h)
+        brickEndY = rect.y + rect.h;
+
+      int clippedWidth = brickEndX - brickStartX;
+      int clippedHeight = brickEndY - brickStartY;
+
+      if (clippedWidth > 0 && clippedHeight > 0) {
+        // Brick highlight (top-left)
+        SDL_SetRenderDrawColor(renderer, 210, 140, 100, 255);
+        if (clippedHeight > 2) {
+          SDL_Rect highlight = {brickStartX, brickStartY, clippedWidth - 2, 2};
+          SDL_RenderFillRect(renderer, &highlight);
+        }
+        if (clippedWidth > 2) {
+          SDL_Rect highlightL = {brickStartX, brickStartY, 2,
+                                 clippedHeight - 2};
+          SDL_RenderFillRect(renderer, &highlightL);
+        }
+
+        // Brick shadow (bottom-right)
+        SDL_SetRenderDrawColor(renderer, 140, 80, 60, 255);
+        if (clippedHeight > 2 && clippedWidth > 4) {
+          SDL_Rect shadow = {brickStartX + 2, brickStartY + clippedHeight - 2,
+                             clippedWidth - 2, 2};
+          SDL_RenderFillRect(renderer, &shadow);
+        }
+        if (clippedWidth > 2 && clippedHeight > 4) {
+          SDL_Rect shadowR = {brickStartX + clippedWidth - 2, brickStartY + 2,
+                              2, clippedHeight - 2};
+          SDL_RenderFillRect(renderer, &shadowR);
+        }
+
+        // Mortar lines (dark gray between bricks)
+        SDL_SetRenderDrawColor(renderer, 100, 70, 50, 255);
+        if (brickEndY <= rect.y + rect.h) {
+          SDL_Rect mortarH = {brickStartX, brickStartY + clippedHeight - 1,
+                              clippedWidth, 1};
+          SDL_RenderFillRect(renderer, &mortarH);
+        }
+        if (brickEndX <= rect.x + rect.w) {
+          SDL_Rect mortarV = {brickStartX + clippedWidth - 1, brickStartY, 1,
+                              clippedHeight};
+          SDL_RenderFillRect(renderer, &mortarV);
+        }
+      }
+    }
+  }
+}
+
+static void drawQuestionBlock(SDL_Renderer *renderer, const SDL_Rect &rect) {
+  // Gradient effect - light to dark orange
+  SDL_SetRenderDrawColor(renderer, 255, 200, 100, 255);
+  SDL_RenderFillRect(renderer, &rect);
+
+  // Top highlight
+  SDL_SetRenderDrawColor(renderer, 255, 230, 150, 255);
+  SDL_Rect highlight = {rect.x + 2, rect.y + 2, rect.w - 4, 8};
+  SDL_RenderFillRect(renderer, &highlight);
+
+  // Bottom shadow
+  SDL_SetRenderDrawColor(renderer, 200, 140, 60, 255);
+  SDL_Rect shadow = {rect.x + 2, rect.y + rect.h - 10, rect.w - 4, 8};
+  SDL_RenderFillRect(renderer, &shadow);
+
+  // Border
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  SDL_RenderDrawRect(renderer, &rect);
+
+  // Draw "?" with more detail
+  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+  SDL_Rect qTop = {rect.x + 10, rect.y + 6, 12, 8};
+  SDL_RenderFillRect(renderer, &qTop);
+  SDL_Rect qMid = {rect.x + 14, rect.y + 12, 8, 6};
+  SDL_RenderFillRect(renderer, &qMid);
+  SDL_Rect qDot = {rect.x + 14, rect.y + 20, 6, 6};
+  SDL_RenderFillRect(renderer, &qDot);
+}
+
+static void drawUsedBlock(SDL_Renderer *renderer, const SDL_Rect &rect) {
+  // Used block - darker with texture
+  SDL_SetRenderDrawColor(renderer, 140, 110, 70, 255);
+  SDL_RenderFillRect(renderer, &rect);
+
+  // Add texture lines
+  SDL_SetRenderDrawColor(renderer, 100, 80, 50, 255);
+  for (int i = 0; i < 4; i++) {
+    SDL_Rect line = {rect.x + i * 8, rect.y, 4, rect.h};
+    SDL_RenderFillRect(renderer, &line);
+  }
+
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  SDL_RenderDrawRect(renderer, &rect);
+}
+
+void TileTextures::drawTile(SDL_Renderer *renderer, TileKind kind,
+                            const SDL_Rect &rect) {
+  switch (kind) {
+  case TileKind::GROUND:
+    drawGroundTile(renderer, rect);
+    break;
+  case TileKind::BRICK:
+    drawBrickTile(renderer, rect);
+    break;
+  case TileKind::QUESTION:
+    drawQuestionBlock(renderer, rect);
+    break;
+  case TileKind::USED:
+    drawUsedBlock(renderer, rect);
+    break;
+  default:
+    break;
+  }
+}
+
+TileTextures::TileTextures() {
+  for (int i = 0; i < static_cast<int>(TileKind::COUNT); i++) {
+    textures[i] = nullptr;
+  }
+}
+
+TileTextures::~TileTextures() { release(); }
+
+void TileTextures::release() {
+  for (int i = 0; i < static_cast<int>(TileKind::COUNT); i++) {
+    if (textures[i]) {
+      SDL_DestroyTexture(textures[i]);
+      textures[i] = nullptr;
+    }
+  }
+}
+
+bool TileTextures::bake(SDL_Renderer *renderer) {
+  release();
+
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  Uint8 r, g, b, a;
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+  bool ok = true;
+  for (int i = 0; i < static_cast<int>(TileKind::COUNT); i++) {
+    TileKind kind = static_cast<TileKind>(i);
+    int h = kind == TileKind::GROUND ? GROUND_HEIGHT : TILE_SIZE;
+
+    SDL_Texture *texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                          SDL_TEXTUREACCESS_TARGET, TILE_SIZE, h);
+    if (!texture || SDL_SetRenderTarget(renderer, texture) != 0) {
+      if (texture)
+        SDL_DestroyTexture(texture);
+      ok = false;
+      continue;
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    SDL_Rect rect = {0, 0, TILE_SIZE, h};
+    drawTile(renderer, kind, rect);
+    textures[i] = texture;
+  }
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+  if (!ok) {
+    std::cout << "Tile baking unavailable, drawing tiles directly: "
+              << SDL_GetError() << std::endl;
+  }
+  return ok;
+}
+
+void TileTextures::draw(SDL_Renderer *renderer, TileKind kind,
+                        const SDL_Rect &dst) {
+  SDL_Texture *texture = textures[static_cast<int>(kind)];
+  if (texture) {
+    SDL_RenderCopy(renderer, texture, nullptr, &dst);
+  } else {
+    drawTile(renderer, kind, dst);
+  }
+}
@@ -1,31 +1,54 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "FramePacer.h"
 #include "Menu.h"
 #include "GameBox.h"
+#include "GameSession.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "ResourceManager.h"
+#include "TextCache.h"
 
 class Game {
 public:
     Game() : window(nullptr), renderer(nullptr), running(true), 
-             state(MENU), fullscreen(false), lastFrameTime(0) {}
+             state(MENU), fullscreen(false), vsync(true), lastFrameTime(0),
+             replayMode(ReplayMode::OFF) {}
     
     ~Game() {
         cleanup();
     }
     
+    // Must be called before init(). Without vsync the game runs uncapped.
+    void setVsync(bool enabled) {
+        vsync = enabled;
+    }
+    
+    // Record every game started from the menu to `path`, or play it back
+    void setReplay(ReplayMode mode, const std::string& path) {
+        replayMode = mode;
+        replayPath = path;
+    }
+    
     bool init() {
         // Wayland compatibility
         SDL_SetHint(SDL_HINT_VIDEO_X11_NET_WM_BYPASS_COMPOSITOR, "0");
         SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0"); // Pixel-perfect for retro
-        SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1");
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, vsync ? "1" : "0");
         
         if (SDL_Init(SDL_INIT_VIDEO) != 0) {
             std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
             return false;
         }
         
-        if (TTF_Init() == -1) {
-            std::cerr << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        // Fonts for the menu and the game are shared through the manager
+        if (!ResourceManager::instance().init()) {
             return false;
         }
         
@@ -61,8 +84,11 @@ public:
         }
         
         // Create renderer
-        renderer = SDL_CreateRenderer(window, -1, 
-            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+        if (vsync) {
+            rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+        }
+        renderer = SDL_CreateRenderer(window, -1, rendererFlags);
         
         if (!renderer) {
             std::cerr << "SDL_CreateRenderer Error: " << SDL_GetError() << std::endl;
@@ -93,23 +119,23 @@ public:
     }
     
     void run() {
-        const int TARGET_FPS = 60;
-        const int FRAME_DELAY = 1000 / TARGET_FPS;
-        
-        Uint32 frameStart;
-        int frameTime;
-        
+        // At full rate frames are paced by vsync in SDL_RenderPresent. The
+        // pacer sleeps between frames when the menu is idle, unfocused or
+        // minimized, and skips drawing while minimized.
+        FramePacer& pacer = FramePacer::instance();
+        pacer.wake();
         while (running) {
-            frameStart = SDL_GetTicks();
+            if (state == LOADING) {
+                pacer.wake(); // Keep the loading animation smooth
+            }
+            pacer.waitForFrame();
             
+            // runGameBox marks its own frames while it plays
+            Profiler::instance().frame();
             handleEvents();
             update();
-            render();
-            
-            frameTime = SDL_GetTicks() - frameStart;
-            
-            if (FRAME_DELAY > frameTime) {
-                SDL_Delay(FRAME_DELAY - frameTime);
+            if (!pacer.isMinimized()) {
+                render();
             }
         }
     }
@@ -121,28 +147,57 @@ private:
     bool running;
     GameState state;
     bool fullscreen;
+    bool vsync;
     int windowWidth;
     int windowHeight;
     Uint32 lastFrameTime;
+    ReplayMode replayMode;
+    std::string replayPath;
+    
+    // The session being loaded or played. Declared before the loader so
+    // the loader thread is joined first on destruction.
+    std::unique_ptr<GameSession> session;
+    // Loads cancelled with ESC. The loader thread may still be filling
+    // them in, so they are only dropped when their finalizer runs.
+    std::vector<std::unique_ptr<GameSession>> cancelledLoads;
+    AssetLoader loader;
     
     void handleEvents() {
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
+            FramePacer::instance().onEvent(e);
+            
             if (e.type == SDL_QUIT) {
                 running = false;
             }
+            else if (e.type == SDL_RENDER_TARGETS_RESET) {
+                // Render target contents are lost on some device resets.
+                // The menu is drawn while loading too, so this is not
+                // left to the menu's own event handling.
+                menu.onRenderTargetsReset();
+            }
             else if (e.type == SDL_KEYDOWN) {
                 // Global hotkeys
                 if (e.key.keysym.sym == SDLK_F11) {
                     toggleFullscreen();
                 }
+                else if (e.key.keysym.sym == SDLK_F4) {
+                    Profiler::instance().toggleOverlay();
+                }
+                else if (e.key.keysym.sym == SDLK_F5) {
+                    Profiler::instance().exportChromeTrace("gamw_trace.json");
+                }
                 else if (e.key.keysym.sym == SDLK_ESCAPE && state == MENU) {
                     running = false;
                 }
                 else if (e.key.keysym.sym == SDLK_ESCAPE && state != MENU) {
-                    // Return to menu from other states
+                    // Return to menu from other states. A cancelled load
+                    // is set aside, so starting again loads a fresh one.
+                    if (state == LOADING && session) {
+                        cancelledLoads.push_back(std::move(session));
+                    }
                     state = MENU;
-                    std::cout << "[*] Returning to menu" << std::endl;
+                    LOG_INFO("[*] Returning to menu");
                 }
             }
             
@@ -158,25 +213,44 @@ private:
         float deltaTime = (currentTime - lastFrameTime) / 1000.0f;
         lastFrameTime = currentTime;
         
-        if (state == MENU) {
+        if (state == MENU || state == LOADING) {
             menu.update(deltaTime);
         }
-        else if (state == PLAYING) {
-            if (!runGameBox(renderer)) {
+        
+        // Finished loads are finalized here, on the main thread, also
+        // when the load was cancelled
+        if (state == LOADING && !session) {
+            startLoading();
+        }
+        loader.finishPending();
+        
+        if (state == PLAYING) {
+            bool playAgain = runGameBox(renderer, *session);
+            if (session->renderTargetsReset) {
+                // Seen by the game loop instead of here
+                menu.onRenderTargetsReset();
+                session->renderTargetsReset = false;
+            }
+            if (!playAgain) {
+                session.reset();
+                // Fonts only the game used can go until the next start
+                ResourceManager::instance().purgeUnused();
                 state = MENU; 
-                std::cout << "[*] Returning from game to menu" << std::endl;
+                LOG_INFO("[*] Returning from game to menu");
             }
         }
         else if (state == SETTINGS) {
             // Settings logic here
         }
+        
+        menu.setLoading(state == LOADING);
     }
     
     void render() {
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
         
-        if (state == MENU) {
+        if (state == MENU || state == LOADING) {
             menu.render(renderer);
         }
         else if (state == PLAYING) {
@@ -186,9 +260,52 @@ private:
             renderSettings();
         }
         
+        PROFILE_ZONE("present");
         SDL_RenderPresent(renderer);
     }
     
+    // Level and world are built on the loader thread while the menu keeps
+    // animating; finishLoading() then uploads fonts and textures here
+    void startLoading() {
+        session.reset(new GameSession());
+        session->setReplay(replayMode, replayPath);
+        
+        int viewWidth, viewHeight;
+        SDL_GetRendererOutputSize(renderer, &viewWidth, &viewHeight);
+        unsigned int seed = static_cast<unsigned int>(std::rand());
+        GameSession* pending = session.get();
+        
+        loader.submit([this, pending, viewWidth, viewHeight, seed]() -> AssetLoader::Finalizer {
+            // Loader thread: no rendering here
+            bool loaded = pending->load(viewWidth, viewHeight, seed);
+            return [this, pending, loaded]() { finishLoading(pending, loaded); };
+        });
+    }
+    
+    void finishLoading(GameSession* pending, bool loaded) {
+        if (pending != session.get()) {
+            // Cancelled with ESC; whatever loaded is thrown away
+            for (size_t i = 0; i < cancelledLoads.size(); i++) {
+                if (cancelledLoads[i].get() == pending) {
+                    cancelledLoads.erase(cancelledLoads.begin() + i);
+                    break;
+                }
+            }
+            return;
+        }
+        
+        if (!loaded) {
+            session.reset();
+            ResourceManager::instance().purgeUnused();
+            state = MENU;
+            LOG_ERROR("[!] Game failed to load");
+            return;
+        }
+        
+        session->upload(renderer);
+        state = PLAYING;
+    }
+    
     void renderSettings() {
         // Placeholder for settings screen
         SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
@@ -205,14 +322,14 @@ private:
         if (fullscreen) {
             SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN_DESKTOP);
             SDL_GetWindowSize(window, &windowWidth, &windowHeight);
-            std::cout << "[*] Fullscreen enabled: " << windowWidth << "x" << windowHeight << std::endl;
+            LOG_INFO("[*] Fullscreen enabled: %dx%d", windowWidth, windowHeight);
         } else {
             SDL_SetWindowFullscreen(window, 0);
             windowWidth = 1280;
             windowHeight = 720;
             SDL_SetWindowSize(window, windowWidth, windowHeight);
             SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
-            std::cout << "[*] Windowed mode: " << windowWidth << "x" << windowHeight << std::endl;
+            LOG_INFO("[*] Windowed mode: %dx%d", windowWidth, windowHeight);
         }
         
         // Reinitialize menu with new dimensions
@@ -220,8 +337,17 @@ private:
     }
     
     void cleanup() {
+        // Wait for a load in flight, then drop the session while the
+        // renderer still exists
+        loader.stop();
+        session.reset();
         menu.cleanup();
         
+        // Fonts and glyph atlases go before the renderer; this also
+        // shuts SDL_ttf down
+        ResourceManager::instance().shutdown();
+        TextCache::instance().clear();
+        
         if (renderer) {
             SDL_DestroyRenderer(renderer);
             renderer = nullptr;
@@ -232,7 +358,6 @@ private:
             window = nullptr;
         }
         
-        TTF_Quit();
         SDL_Quit();
         
         std::cout << "[*] Cleanup complete" << std::endl;
@@ -242,15 +367,37 @@ private:
 int main(int argc, char* argv[]) {
     std::cout << "Starting Super Gamw Bros..." << std::endl;
     
+    // Game messages go through the ring-buffer logger, written out by its
+    // own thread so stdout never stalls a frame
+    Logger& logger = Logger::instance();
+    logger.start();
+    
     Game game;
     
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--no-vsync") {
+            game.setVsync(false);
+        }
+        else if (std::string(argv[i]) == "--verbose") {
+            logger.setLevel(LOG_LEVEL_DEBUG);
+        }
+        else if (std::string(argv[i]) == "--record" && i + 1 < argc) {
+            game.setReplay(ReplayMode::RECORD, argv[++i]);
+        }
+        else if (std::string(argv[i]) == "--replay" && i + 1 < argc) {
+            game.setReplay(ReplayMode::PLAY, argv[++i]);
+        }
+    }
+    
     if (!game.init()) {
+        logger.stop();
         std::cerr << "[!] Failed to initialize game" << std::endl;
         return 1;
     }
     
     game.run();
     
+    logger.stop();
     std::cout << "Game closed successfully" << std::endl;
     return 0;
 }
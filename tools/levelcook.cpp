@@ -0,0 +1,46 @@
+// Offline level cooker: text level in, binary .lvl out.
+// The game maps .lvl files and uses them in place (see CookedLevel.h).
+//
+// Usage: levelcook input.txt output.lvl
+
+#include "CookedLevel.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " input.txt output.lvl" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> rows;
+  if (!CookedLevel::readTextRows(argv[1], rows) || rows.empty()) {
+    std::cerr << "Cannot read level: " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::vector<unsigned char> bytes;
+  if (!CookedLevel::cook(rows, bytes))
+    return 1;
+
+  FILE *out = fopen(argv[2], "wb");
+  if (!out || fwrite(bytes.data(), 1, bytes.size(), out) != bytes.size()) {
+    std::cerr << "Cannot write: " << argv[2] << std::endl;
+    if (out)
+      fclose(out);
+    return 1;
+  }
+  fclose(out);
+
+  // Read it back through the runtime path to catch a bad file early
+  CookedLevel check;
+  if (!check.openCooked(argv[2]))
+    return 1;
+
+  std::cout << argv[1] << " -> " << argv[2] << ": " << check.getColumns()
+            << "x" << check.getRows() << " tiles, " << bytes.size()
+            << " bytes" << std::endl;
+  return 0;
+}